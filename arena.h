@@ -0,0 +1,88 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/** @class Arena
+ *  @brief Chunked bump allocator with O(1) whole-arena reset
+ *
+ * Purpose: keep simulator metadata (radix page-table nodes, eviction
+ * bookkeeping, replay scratch) off malloc on the hot path. Allocation
+ * is a pointer bump; when the current chunk is exhausted the arena
+ * grows by another chunk (which is the only time the system allocator
+ * is touched). reset() rewinds to the first chunk without releasing
+ * any memory, so replaying the next trace of a batch reuses the warm
+ * chunks instead of tearing structures down and rebuilding them.
+ *
+ * Only trivially destructible types belong in an arena - reset() does
+ * not run destructors.
+ */
+class Arena {
+  private:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    size_t chunkSize;
+    size_t currentChunk = 0;
+    size_t offset = 0;
+
+    void addChunk() {
+        chunks.push_back(std::make_unique<char[]>(chunkSize));
+    }
+
+  public:
+    explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE) : chunkSize(chunkSize) {
+        addChunk();
+    }
+
+    /**
+     * Bump-allocates raw storage
+     * @param bytes allocation size (must fit in one chunk)
+     * @param alignment required alignment, power of two
+     * @return pointer to uninitialized storage owned by the arena
+     */
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (bytes + alignment > chunkSize) {
+            // an allocation can never span chunks; failing loudly beats
+            // silently writing past the chunk's end
+            std::cerr << "Error: arena allocation of " << bytes
+                      << " bytes exceeds chunk size " << chunkSize << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + bytes > chunkSize) {
+            // current chunk exhausted: move to the next (grow if needed)
+            currentChunk++;
+            if (currentChunk == chunks.size()) {
+                addChunk();
+            }
+            aligned = 0;
+        }
+        offset = aligned + bytes;
+        return chunks[currentChunk].get() + aligned;
+    }
+
+    /**
+     * Constructs a T in the arena (T must be trivially destructible)
+     */
+    template <typename T, typename... Args>
+    T *create(Args &&...args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Rewinds the whole arena in O(1), keeping every chunk for reuse
+     */
+    void reset() {
+        currentChunk = 0;
+        offset = 0;
+    }
+
+    /** @return total bytes of chunk capacity currently held */
+    size_t getCapacity() const {
+        return chunks.size() * chunkSize;
+    }
+};
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "vmm_config.h"
+
+#if __has_include(<liburing.h>)
+#include <liburing.h>
+#define VMM_HAVE_IO_URING 1
+#else
+#define VMM_HAVE_IO_URING 0
+#endif
+
+// queue depth for the ring / worker count for the fallback pool
+#define ASYNC_FAULT_DEPTH 32
+#define ASYNC_FAULT_WORKERS 4
+
+/** @class AsyncFaultEngine
+ *  @brief Out-of-order fault servicing for the batched pipeline
+ *
+ * The synchronous fault path stops the loop dead on every
+ * backingStore read. With this engine the lookup stage submits each
+ * faulting page's read the moment the fault is discovered and keeps
+ * translating; reads complete out of order in the background, and the
+ * pipeline only synchronizes once, before the value stage needs the
+ * data - fault latency becomes overlapped bandwidth.
+ *
+ * Backed by io_uring where the headers are available (one sqe per
+ * page read, completions drained without ordering), and by a small
+ * pread thread pool elsewhere; both present the same submit/waitAll
+ * surface, so the engine does not care which it got.
+ */
+class AsyncFaultEngine {
+  private:
+    std::string fileName;
+
+#if VMM_HAVE_IO_URING
+    struct io_uring ring{};
+    int fd = -1;
+    unsigned inFlight = 0;
+#else
+    struct ReadRequest {
+        uint32_t pageNumber;
+        int8_t *destination;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<ReadRequest> queue;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    unsigned inFlight = 0;
+    bool shuttingDown = false;
+    bool ioFailed = false;
+
+    /**
+     * Worker body: drain queued page reads with a private descriptor
+     */
+    void workerLoop() {
+        int workerFd = open(fileName.c_str(), O_RDONLY);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (workerFd < 0) {
+            // cannot serve reads, but never abandon them: fail each
+            // request so waitAll() surfaces the error instead of hanging
+            ioFailed = true;
+        }
+        while (true) {
+            workReady.wait(lock, [&] { return !queue.empty() || shuttingDown; });
+            if (shuttingDown && queue.empty()) {
+                if (workerFd >= 0)
+                    close(workerFd);
+                return;
+            }
+
+            ReadRequest request = queue.front();
+            queue.pop_front();
+
+            ssize_t bytes = -1;
+            if (workerFd >= 0) {
+                lock.unlock();
+                bytes = pread(workerFd, request.destination, PAGE_SIZE,
+                              static_cast<off_t>(request.pageNumber) * PAGE_SIZE);
+                lock.lock();
+            }
+
+            if (bytes != PAGE_SIZE) {
+                ioFailed = true;
+            }
+            inFlight--;
+            if (inFlight == 0) {
+                workDone.notify_all();
+            }
+        }
+    }
+#endif
+
+  public:
+    /**
+     * Constructor: open the store for async reads
+     * @param fileName backing store path
+     */
+    explicit AsyncFaultEngine(const std::string &fileName) : fileName(fileName) {
+#if VMM_HAVE_IO_URING
+        fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0 || io_uring_queue_init(ASYNC_FAULT_DEPTH, &ring, 0) != 0) {
+            std::cerr << "Error initializing io_uring fault engine" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+#else
+        workers.reserve(ASYNC_FAULT_WORKERS);
+        for (int worker = 0; worker < ASYNC_FAULT_WORKERS; worker++) {
+            workers.emplace_back(&AsyncFaultEngine::workerLoop, this);
+        }
+#endif
+    }
+
+    ~AsyncFaultEngine() {
+#if VMM_HAVE_IO_URING
+        io_uring_queue_exit(&ring);
+        if (fd >= 0)
+            close(fd);
+#else
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            shuttingDown = true;
+        }
+        workReady.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+#endif
+    }
+
+    /**
+     * Submits one page read; returns immediately, the data lands in
+     * destination some time before waitAll() returns
+     * @param pageNumber page to read
+     * @param destination PAGE_SIZE bytes of frame storage
+     */
+    void submitRead(uint8_t pageNumber, int8_t *destination) {
+#if VMM_HAVE_IO_URING
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+        if (sqe == nullptr) {
+            // ring full: let completions drain, then retry once
+            drainCompletions(1);
+            sqe = io_uring_get_sqe(&ring);
+        }
+        io_uring_prep_read(sqe, fd, destination, PAGE_SIZE,
+                           static_cast<off_t>(pageNumber) * PAGE_SIZE);
+        io_uring_submit(&ring);
+        inFlight++;
+#else
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            queue.push_back({pageNumber, destination});
+            inFlight++;
+        }
+        workReady.notify_one();
+#endif
+    }
+
+#if VMM_HAVE_IO_URING
+  private:
+    /** Reaps at least minCompletions finished reads, out of order */
+    void drainCompletions(unsigned minCompletions) {
+        while (minCompletions > 0 && inFlight > 0) {
+            struct io_uring_cqe *cqe = nullptr;
+            if (io_uring_wait_cqe(&ring, &cqe) != 0 || cqe->res != PAGE_SIZE) {
+                std::cerr << "Error reading page from backing store" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            io_uring_cqe_seen(&ring, cqe);
+            inFlight--;
+            if (minCompletions > 0)
+                minCompletions--;
+        }
+    }
+
+  public:
+#endif
+
+    /**
+     * Blocks until every submitted read has landed
+     */
+    void waitAll() {
+#if VMM_HAVE_IO_URING
+        drainCompletions(inFlight);
+#else
+        std::unique_lock<std::mutex> lock(mutex);
+        workDone.wait(lock, [&] { return inFlight == 0; });
+        if (ioFailed) {
+            std::cerr << "Error reading page from backing store" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+#endif
+    }
+};
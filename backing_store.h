@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vmm_config.h"
+
+/** @class BackingStore
+ *  @brief Simulates secondary storage for page loading
+ *
+ * Two access modes:
+ *  - mapped (default): the whole file is mmap'd once at startup and
+ *    pageData() hands out zero-copy pointers straight into the mapping,
+ *    so a page fault costs no syscall and no buffer copy
+ *  - streamed: the original seekg/read path through std::ifstream, kept
+ *    as a fallback when mmap is unavailable (or explicitly disabled)
+ *
+ * Optional readahead (setReadahead): a fault on page N asynchronously
+ * stages pages N+1..N+K, so a sequential sweep through a cold region
+ * finds its next pages already waiting. In mapped mode the kernel does
+ * the staging (madvise WILLNEED); in streamed mode a prefetch thread
+ * with its own file handle fills a staging cache that readPage checks
+ * before touching the file.
+ */
+class BackingStore {
+  private:
+    std::string fileName;
+    std::ifstream backingStoreFile;
+
+    // write-back handle, opened on the first dirty eviction
+    std::fstream writeFile;
+
+    // mmap state, only populated in mapped mode
+    const int8_t *mappedBase = nullptr;
+    size_t mappedLength = 0;
+
+    // readahead configuration (0 -> off)
+    unsigned readaheadPages = 0;
+
+    // streamed-mode staging cache, filled by the prefetch thread
+    std::unordered_map<uint8_t, std::vector<int8_t>> stagingCache;
+    std::mutex stagingMutex;
+    std::condition_variable prefetchWork;
+    std::deque<uint8_t> prefetchQueue;
+    std::thread prefetchThread;
+    bool prefetchShutdown = false;
+
+    // bumped (under stagingMutex) by every write-back; a prefetch that
+    // overlapped a write is discarded instead of staging stale bytes
+    uint64_t writeGeneration = 0;
+
+    /**
+     * Prefetch thread body: stage queued pages with a private handle
+     */
+    void prefetchLoop() {
+        // own handle so staging never contends with the fault path reads
+        std::ifstream prefetchFile(fileName, std::ios::binary);
+        if (!prefetchFile)
+            return;
+
+        std::unique_lock<std::mutex> lock(stagingMutex);
+        while (true) {
+            prefetchWork.wait(lock, [&] { return !prefetchQueue.empty() || prefetchShutdown; });
+            if (prefetchShutdown)
+                return;
+
+            uint8_t pageNumber = prefetchQueue.front();
+            prefetchQueue.pop_front();
+            if (stagingCache.count(pageNumber)) {
+                continue; // already staged
+            }
+
+            uint64_t generationAtRead = writeGeneration;
+
+            lock.unlock();
+            std::vector<int8_t> pageData(PAGE_SIZE);
+            prefetchFile.clear();
+            prefetchFile.seekg(static_cast<std::streamoff>(pageNumber) * PAGE_SIZE, std::ios::beg);
+            prefetchFile.read(reinterpret_cast<char *>(pageData.data()), PAGE_SIZE);
+            bool good = static_cast<bool>(prefetchFile);
+            lock.lock();
+
+            // a write-back landed while we read: the bytes may predate
+            // it, so drop them rather than staging stale data
+            if (good && writeGeneration == generationAtRead) {
+                stagingCache.emplace(pageNumber, std::move(pageData));
+            }
+        }
+    }
+
+    /**
+     * Queues pages N+1..N+K for staging after a fault on page N
+     */
+    void scheduleReadahead(uint8_t pageNumber) {
+        if (readaheadPages == 0)
+            return;
+
+        if (mappedBase != nullptr) {
+            // mapped mode: let the kernel stage the neighbours
+            size_t offset = static_cast<size_t>(pageNumber) * PAGE_SIZE;
+            size_t length = std::min(static_cast<size_t>(readaheadPages + 1) * PAGE_SIZE,
+                                     mappedLength - offset);
+            madvise(const_cast<int8_t *>(mappedBase) + offset, length, MADV_WILLNEED);
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(stagingMutex);
+        for (unsigned ahead = 1; ahead <= readaheadPages; ahead++) {
+            unsigned next = pageNumber + ahead;
+            if (next >= PAGE_TABLE_SIZE)
+                break;
+            if (!stagingCache.count(static_cast<uint8_t>(next))) {
+                prefetchQueue.push_back(static_cast<uint8_t>(next));
+            }
+        }
+        prefetchWork.notify_one();
+    }
+
+  public:
+    /**
+     * Constructor: Open BACKING_STORE.bin file
+     * @param fileName path to the BACKING_STORE.bin file
+     * @param useMmap attempt to memory-map the store (default true)
+     *
+     * Terminate if file cannot be opened
+     */
+    explicit BackingStore(const std::string &fileName, bool useMmap = true)
+        : fileName(fileName) {
+        if (useMmap) {
+            int fd = open(fileName.c_str(), O_RDONLY);
+            if (fd >= 0) {
+                struct stat fileStat{};
+                if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+                    // MAP_SHARED keeps the mapping coherent with the
+                    // write-back engine's file writes
+                    void *base = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                    if (base != MAP_FAILED) {
+                        mappedBase = static_cast<const int8_t *>(base);
+                        mappedLength = fileStat.st_size;
+                    }
+                }
+                // fd not needed once the mapping exists (or failed)
+                close(fd);
+            }
+            if (mappedBase != nullptr)
+                return;
+            // fall through to the streamed path if mapping failed
+        }
+
+        backingStoreFile.open(fileName, std::ios::binary);
+        if (!backingStoreFile) {
+            std::cerr << "Error opening backing store file: " << fileName << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /**
+     * Destructor: Ensure file/mapping/prefetcher is released
+     */
+    ~BackingStore() {
+        if (prefetchThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> guard(stagingMutex);
+                prefetchShutdown = true;
+            }
+            prefetchWork.notify_one();
+            prefetchThread.join();
+        }
+        if (mappedBase != nullptr) {
+            munmap(const_cast<int8_t *>(mappedBase), mappedLength);
+        }
+        if (backingStoreFile.is_open()) {
+            backingStoreFile.close();
+        }
+    }
+
+    /**
+     * Enables readahead of K pages past every faulting page
+     * @param pages readahead depth (0 disables)
+     */
+    void setReadahead(unsigned pages) {
+        readaheadPages = pages;
+        if (pages > 0 && mappedBase == nullptr && !prefetchThread.joinable()) {
+            prefetchThread = std::thread(&BackingStore::prefetchLoop, this);
+        }
+    }
+
+    /**
+     * Requests readahead past a faulting page (the zero-copy alias
+     * path bypasses readPage, so the engine calls this directly)
+     */
+    void prefetch(uint8_t pageNumber) {
+        scheduleReadahead(pageNumber);
+    }
+
+    /**
+     * @return true when the store is memory-mapped and pageData() is usable
+     */
+    bool isMapped() const {
+        return mappedBase != nullptr;
+    }
+
+    /**
+     * Zero-copy access to a page in the mapped store
+     * @param pageNumber page to fetch
+     * @return pointer straight into the mapping, valid for the store's lifetime
+     */
+    const int8_t *pageData(uint8_t pageNumber) const {
+        size_t offset = static_cast<size_t>(pageNumber) * PAGE_SIZE;
+        if (mappedBase == nullptr || offset + PAGE_SIZE > mappedLength) {
+            std::cerr << "Error reading page from backing store" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        return mappedBase + offset;
+    }
+
+    /**
+     * Read a specific page from the backing store
+     * @param pageNumber page to fetch
+     * @param buffer output buffer to store the page contents
+     */
+    void readPage(uint8_t pageNumber, int8_t *buffer) {
+        if (mappedBase != nullptr) {
+            // mapped mode: single copy out of the mapping, no syscalls
+            std::copy_n(pageData(pageNumber), PAGE_SIZE, buffer);
+            scheduleReadahead(pageNumber);
+            return;
+        }
+
+        if (readaheadPages > 0) {
+            // staged by the prefetcher? skip the file entirely
+            std::unique_lock<std::mutex> lock(stagingMutex);
+            auto staged = stagingCache.find(pageNumber);
+            if (staged != stagingCache.end()) {
+                std::copy_n(staged->second.data(), PAGE_SIZE, buffer);
+                lock.unlock();
+                scheduleReadahead(pageNumber);
+                return;
+            }
+        }
+
+        backingStoreFile.clear(); // Clear any error flags
+        backingStoreFile.seekg(pageNumber * PAGE_SIZE, std::ios::beg);
+        backingStoreFile.read(reinterpret_cast<char *>(buffer), 256);
+
+        if (!backingStoreFile) {
+            std::cerr << "Error reading page from backing store" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        scheduleReadahead(pageNumber);
+    }
+
+    /**
+     * Writes a run of contiguous pages back to the store with one
+     * sequential write (write-back path for dirty evicted pages)
+     * @param firstPage first page of the run
+     * @param pageCount number of contiguous pages
+     * @param data pageCount * PAGE_SIZE bytes to write
+     */
+    void writeRange(uint8_t firstPage, size_t pageCount, const int8_t *data) {
+        // drop any staged copies of the pages being rewritten - the
+        // prefetcher captured pre-store bytes, and a later re-fault
+        // must never be served from them; the generation bump also
+        // discards prefetch reads overlapping this write
+        if (readaheadPages > 0 && mappedBase == nullptr) {
+            std::lock_guard<std::mutex> guard(stagingMutex);
+            writeGeneration++;
+            for (size_t page = 0; page < pageCount; page++) {
+                stagingCache.erase(static_cast<uint8_t>(firstPage + page));
+            }
+        }
+
+        if (!writeFile.is_open()) {
+            // lazily opened: most replays never write
+            writeFile.open(fileName, std::ios::binary | std::ios::in | std::ios::out);
+            if (!writeFile) {
+                std::cerr << "Error opening backing store for write-back" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        writeFile.seekp(static_cast<std::streamoff>(firstPage) * PAGE_SIZE, std::ios::beg);
+        writeFile.write(reinterpret_cast<const char *>(data),
+                        static_cast<std::streamsize>(pageCount * PAGE_SIZE));
+        writeFile.flush();
+
+        if (!writeFile) {
+            std::cerr << "Error writing page to backing store" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /**
+     * Reads a run of contiguous pages with one file round trip
+     * (fault-clustering path for the batched pipeline)
+     * @param firstPage first page of the run
+     * @param pageCount number of contiguous pages
+     * @param buffer output, pageCount * PAGE_SIZE bytes
+     */
+    void readRange(uint8_t firstPage, size_t pageCount, int8_t *buffer) {
+        if (mappedBase != nullptr) {
+            size_t offset = static_cast<size_t>(firstPage) * PAGE_SIZE;
+            if (offset + pageCount * PAGE_SIZE > mappedLength) {
+                std::cerr << "Error reading page from backing store" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            std::copy_n(mappedBase + offset, pageCount * PAGE_SIZE, buffer);
+            return;
+        }
+
+        backingStoreFile.clear();
+        backingStoreFile.seekg(static_cast<std::streamoff>(firstPage) * PAGE_SIZE, std::ios::beg);
+        backingStoreFile.read(reinterpret_cast<char *>(buffer),
+                              static_cast<std::streamsize>(pageCount * PAGE_SIZE));
+
+        if (!backingStoreFile) {
+            std::cerr << "Error reading page from backing store" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+};
@@ -1,25 +1,205 @@
 //
 // Created by Neil Haria on 04/12/24.
 //
-#include <stdio.h>
-#include <stdlib.h>
+// Originally a fixed 256-page filler; now the workload generator for
+// the replay engine. Two subcommands:
+//
+//   store [--pages=N] [--seed=S] [--out=FILE]
+//       writes an N-page backing store of seeded pseudo-random bytes
+//       (defaults reproduce the classic 256-page BACKING_STORE.bin)
+//
+//   trace OUT.trace --count=N [--dist=sequential|uniform|zipf]
+//         [--skew=Z] [--pages=P] [--phases=K] [--working-set=W]
+//         [--seed=S]
+//       emits N addresses straight in the packed binary trace format.
+//       dist picks the page-popularity distribution; --phases splits
+//       the trace into K working-set phases of W pages each, shifting
+//       across the page space over time, so temporal locality can be
+//       modeled as well as skew.
+//
+// Everything is driven by a seeded xorshift PRNG - multi-hundred-
+// million-address inputs generate in seconds, reproducibly.
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "binary_trace.h"
+#include "workload_gen.h"
+
+namespace {
+
+constexpr size_t GENERATOR_PAGE_SIZE = 256;
+constexpr size_t OUTPUT_BLOCK_RECORDS = 1 << 16;
+
+/** Parses --key=value style options shared by both subcommands */
+struct GeneratorOptions {
+    std::string outFile;
+    size_t pages = 256;
+    size_t count = 0;
+    std::string distribution = "uniform";
+    double skew = 0.99;
+    size_t phases = 1;
+    size_t workingSet = 0; // 0 -> whole page space
+    uint64_t seed = 1;
+};
+
+bool parseOption(const std::string &option, GeneratorOptions &options) {
+    if (option.rfind("--pages=", 0) == 0) {
+        options.pages = std::stoul(option.substr(8));
+    } else if (option.rfind("--count=", 0) == 0) {
+        options.count = std::stoul(option.substr(8));
+    } else if (option.rfind("--dist=", 0) == 0) {
+        options.distribution = option.substr(7);
+    } else if (option.rfind("--skew=", 0) == 0) {
+        options.skew = std::stod(option.substr(7));
+    } else if (option.rfind("--phases=", 0) == 0) {
+        options.phases = std::stoul(option.substr(9));
+    } else if (option.rfind("--working-set=", 0) == 0) {
+        options.workingSet = std::stoul(option.substr(14));
+    } else if (option.rfind("--seed=", 0) == 0) {
+        options.seed = std::stoull(option.substr(7));
+    } else if (option.rfind("--out=", 0) == 0) {
+        options.outFile = option.substr(6);
+    } else {
+        std::cerr << "Unknown option: " << option << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/** store subcommand: N pages of seeded pseudo-random bytes */
+int generateStore(const GeneratorOptions &options) {
+    std::string fileName = options.outFile.empty() ? "BACKING_STORE.bin" : options.outFile;
+    std::ofstream store(fileName, std::ios::binary);
+    if (!store) {
+        std::cerr << "Error opening output file: " << fileName << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Xorshift rng(options.seed);
+    std::vector<uint8_t> page(GENERATOR_PAGE_SIZE);
+    for (size_t pageNumber = 0; pageNumber < options.pages; pageNumber++) {
+        for (uint8_t &byte : page) {
+            byte = static_cast<uint8_t>(rng.next());
+        }
+        store.write(reinterpret_cast<const char *>(page.data()), page.size());
+    }
+
+    if (!store) {
+        std::cerr << "Error writing backing store" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << options.pages << " pages to " << fileName << std::endl;
+    return EXIT_SUCCESS;
+}
+
+/** trace subcommand: N binary records under the chosen distribution */
+int generateTrace(const GeneratorOptions &options) {
+    if (options.outFile.empty() || options.count == 0) {
+        std::cerr << "Usage: ./backing_store_filler trace out" << BINARY_TRACE_EXTENSION
+                  << " --count=N [--dist=sequential|uniform|zipf] [--skew=Z]"
+                     " [--pages=P] [--phases=K] [--working-set=W] [--seed=S]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (options.pages == 0 || options.phases == 0) {
+        std::cerr << "Error: --pages and --phases must be at least 1" << std::endl;
+        return EXIT_FAILURE;
+    }
 
-int main() {
-    FILE *file = fopen("BACKING_STORE.bin", "wb");
-    if (!file) {
-        perror("Failed to open file");
-        return 1;
+    std::ofstream trace(options.outFile, std::ios::binary);
+    if (!trace) {
+        std::cerr << "Error opening output file: " << options.outFile << std::endl;
+        return EXIT_FAILURE;
     }
 
-    // Write 256 pages of 256 bytes each (e.g., random data)
-    for (int i = 0; i < 256; ++i) {
-        unsigned char page[256];
-        for (int j = 0; j < 256; ++j) {
-            page[j] = rand() % 256; // Random byte
+    size_t pageSpace = options.pages;
+    size_t workingSet = options.workingSet == 0 ? pageSpace : options.workingSet;
+    if (workingSet > pageSpace)
+        workingSet = pageSpace;
+
+    Xorshift rng(options.seed);
+    ZipfianGenerator zipf(workingSet, options.skew, options.seed ^ 0x5A1BF00Dull);
+
+    std::vector<uint32_t> block;
+    block.reserve(OUTPUT_BLOCK_RECORDS);
+
+    size_t recordsPerPhase = (options.count + options.phases - 1) / options.phases;
+
+    for (size_t i = 0; i < options.count; i++) {
+        // working-set phases shift a window across the page space
+        size_t phase = std::min(i / recordsPerPhase, options.phases - 1);
+        size_t phaseBase = options.phases > 1
+                ? phase * ((pageSpace - workingSet) / (options.phases - 1))
+                : 0;
+
+        size_t pageInSet;
+        if (options.distribution == "sequential") {
+            pageInSet = i % workingSet;
+        } else if (options.distribution == "uniform") {
+            pageInSet = rng.next() % workingSet;
+        } else if (options.distribution == "zipf") {
+            pageInSet = zipf.next();
+        } else {
+            std::cerr << "Unknown distribution: " << options.distribution << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        uint32_t pageNumber = static_cast<uint32_t>((phaseBase + pageInSet) % pageSpace);
+        uint32_t offset = static_cast<uint32_t>(rng.next() & (GENERATOR_PAGE_SIZE - 1));
+        block.push_back((pageNumber << 8) | offset);
+
+        if (block.size() == OUTPUT_BLOCK_RECORDS) {
+            trace.write(reinterpret_cast<const char *>(block.data()),
+                        block.size() * sizeof(uint32_t));
+            block.clear();
+        }
+    }
+    if (!block.empty()) {
+        trace.write(reinterpret_cast<const char *>(block.data()),
+                    block.size() * sizeof(uint32_t));
+    }
+
+    if (!trace) {
+        std::cerr << "Error writing trace" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << options.count << " records to " << options.outFile << std::endl;
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: ./backing_store_filler store|trace [options]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string command = argv[1];
+    GeneratorOptions options;
+
+    int firstOption = 2;
+    if (command == "trace" && argc >= 3 && std::string(argv[2]).rfind("--", 0) != 0) {
+        options.outFile = argv[2];
+        firstOption = 3;
+    }
+
+    for (int arg = firstOption; arg < argc; arg++) {
+        if (!parseOption(argv[arg], options)) {
+            return EXIT_FAILURE;
         }
-        fwrite(page, sizeof(unsigned char), 256, file);
     }
 
-    fclose(file);
-    return 0;
+    if (command == "store")
+        return generateStore(options);
+    if (command == "trace")
+        return generateTrace(options);
+
+    std::cerr << "Unknown command: " << command << std::endl;
+    return EXIT_FAILURE;
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <bit>
+#include <iostream>
+#include <span>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Packed binary trace format: a flat sequence of fixed-width
+// little-endian uint32 logical addresses, no header, no padding.
+// Produced by the trace_converter tool from addresses.txt-style files.
+#define BINARY_TRACE_EXTENSION ".trace"
+
+// the reader hands out raw pointers into the file, so the build must
+// target a little-endian machine for the on-disk format to match
+static_assert(std::endian::native == std::endian::little,
+              "binary trace format is little-endian");
+
+/** @class BinaryTraceFile
+ *  @brief mmap'd view over a packed binary address trace
+ *
+ * The whole file is mapped once and records() exposes it as a span of
+ * raw uint32_t - iterating the trace costs no per-record allocation,
+ * text decoding, or copy.
+ */
+class BinaryTraceFile {
+  private:
+    const uint32_t *mappedBase = nullptr;
+    size_t recordCount = 0;
+    size_t mappedLength = 0;
+
+  public:
+    /**
+     * Constructor: map the whole trace file
+     * @param fileName path to the packed binary trace
+     *
+     * Terminate if the file cannot be opened or is not a whole number
+     * of uint32 records
+     */
+    explicit BinaryTraceFile(const std::string &fileName) {
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Error opening address file: " << fileName << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size % sizeof(uint32_t) != 0) {
+            std::cerr << "Error: " << fileName << " is not a valid binary trace" << std::endl;
+            close(fd);
+            exit(EXIT_FAILURE);
+        }
+
+        if (fileStat.st_size > 0) {
+            void *base = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                std::cerr << "Error mapping binary trace: " << fileName << std::endl;
+                close(fd);
+                exit(EXIT_FAILURE);
+            }
+            mappedBase = static_cast<const uint32_t *>(base);
+            mappedLength = fileStat.st_size;
+            recordCount = fileStat.st_size / sizeof(uint32_t);
+        }
+        close(fd);
+    }
+
+    /**
+     * Destructor: release the mapping
+     */
+    ~BinaryTraceFile() {
+        if (mappedBase != nullptr) {
+            munmap(const_cast<uint32_t *>(mappedBase), mappedLength);
+        }
+    }
+
+    // the mapping is owned, not shareable
+    BinaryTraceFile(const BinaryTraceFile &) = delete;
+    BinaryTraceFile &operator=(const BinaryTraceFile &) = delete;
+
+    /**
+     * @return the whole trace as raw records, zero-copy
+     */
+    std::span<const uint32_t> records() const {
+        return {mappedBase, recordCount};
+    }
+};
+
+/**
+ * @param fileName candidate trace path
+ * @return true when the file name carries the binary trace extension
+ */
+inline bool isBinaryTrace(const std::string &fileName) {
+    const std::string extension = BINARY_TRACE_EXTENSION;
+    return fileName.size() > extension.size() &&
+           fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0;
+}
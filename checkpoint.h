@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+// fixed-layout, mmap-friendly checkpoint image: every field sits at a
+// compile-time offset, so a restore can map the file and memcpy the
+// sections straight out (and a future reader can alias them in place)
+#define CHECKPOINT_MAGIC 0x4B434D56u // "VMCK"
+#define CHECKPOINT_VERSION 1u
+
+// large enough for every TLB variant, including the 1536-entry hierarchy
+#define CHECKPOINT_MAX_TLB_ENTRIES 2048
+
+/** @struct CheckpointTlbEntry
+ *  @brief One cached translation, in recency order (oldest first)
+ */
+struct CheckpointTlbEntry {
+    uint8_t pageNumber;
+    uint8_t frameNumber;
+};
+
+/** @struct CheckpointImage
+ *  @brief The whole simulator state as one POD image
+ *
+ * Saved after a warmup replay and loaded before an experiment, so the
+ * expensive warm state (page table, TLB contents, resident frames,
+ * counters) comes back in one read instead of hours of re-simulation.
+ */
+struct CheckpointImage {
+    uint32_t magic;
+    uint32_t version;
+
+    // statistics counters, so rates continue across the restore
+    int64_t totalAddresses;
+    int64_t tlbHits;
+    int64_t pageFaults;
+
+    // frame bump-allocator position (unlimited mode)
+    uint16_t nextAvailableFrame;
+
+    // TLB contents in recency order, oldest first
+    uint16_t tlbEntryCount;
+    std::array<CheckpointTlbEntry, CHECKPOINT_MAX_TLB_ENTRIES> tlbEntries;
+
+    // page table: page -> frame, -1 invalid
+    std::array<int16_t, PAGE_TABLE_SIZE> pageTable;
+
+    // resident frame data
+    std::array<std::array<int8_t, FRAME_SIZE>, FRAMES> frameData;
+};
+
+static_assert(sizeof(CheckpointImage) < (1 << 18), "checkpoint image should stay compact");
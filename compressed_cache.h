@@ -0,0 +1,237 @@
+#pragma once
+
+#include <deque>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "vmm_config.h"
+
+// default pool budget for compressed victims (bytes)
+#define VICTIM_CACHE_DEFAULT_BYTES (16 * 1024)
+
+/**
+ * Tiny LZ-class codec for 256-byte frames: LZ4-style tokens (literal
+ * run + back-reference with one-byte offset, minimum match 4) over a
+ * rolling 3-byte hash. Pages that do not compress are kept in stored
+ * form, so the worst case is PAGE_SIZE + 1 bytes. Compression and
+ * decompression are a few hundred nanoseconds per page - cheap enough
+ * to sit on the eviction path.
+ */
+namespace frame_codec {
+
+constexpr uint8_t STORED_MARKER = 0;
+constexpr uint8_t COMPRESSED_MARKER = 1;
+constexpr int MIN_MATCH = 4;
+
+inline uint32_t hash3(const uint8_t *data) {
+    return ((data[0] << 16) ^ (data[1] << 8) ^ data[2]) * 2654435761u >> 24;
+}
+
+/**
+ * Compresses one frame
+ * @param frame PAGE_SIZE input bytes
+ * @param out receives marker byte + payload
+ */
+inline void compressFrame(const int8_t *frame, std::vector<uint8_t> &out) {
+    const uint8_t *input = reinterpret_cast<const uint8_t *>(frame);
+    out.clear();
+    out.push_back(COMPRESSED_MARKER);
+
+    int16_t hashTable[256];
+    std::memset(hashTable, -1, sizeof(hashTable));
+
+    unsigned position = 0;
+    unsigned literalStart = 0;
+
+    auto flushLiterals = [&](unsigned end) {
+        unsigned literalCount = end - literalStart;
+        while (literalCount > 0) {
+            unsigned chunk = literalCount > 255 ? 255 : literalCount;
+            out.push_back(0); // match length 0 -> literal run follows
+            out.push_back(static_cast<uint8_t>(chunk));
+            out.insert(out.end(), input + literalStart, input + literalStart + chunk);
+            literalStart += chunk;
+            literalCount -= chunk;
+        }
+    };
+
+    while (position + MIN_MATCH <= PAGE_SIZE) {
+        uint32_t hash = hash3(input + position);
+        int16_t candidate = hashTable[hash];
+        hashTable[hash] = static_cast<int16_t>(position);
+
+        unsigned matchLength = 0;
+        if (candidate >= 0) {
+            unsigned limit = PAGE_SIZE - position;
+            while (matchLength < limit &&
+                   input[candidate + matchLength] == input[position + matchLength]) {
+                matchLength++;
+            }
+        }
+
+        if (matchLength >= MIN_MATCH) {
+            flushLiterals(position);
+            // token: match length (capped 255), offset back to candidate
+            unsigned emit = matchLength > 255 ? 255 : matchLength;
+            out.push_back(static_cast<uint8_t>(emit));
+            out.push_back(static_cast<uint8_t>(position - candidate));
+            position += emit;
+            literalStart = position;
+        } else {
+            position++;
+        }
+    }
+    flushLiterals(PAGE_SIZE);
+
+    if (out.size() >= PAGE_SIZE + 1) {
+        // incompressible: keep the raw bytes instead
+        out.clear();
+        out.push_back(STORED_MARKER);
+        out.insert(out.end(), input, input + PAGE_SIZE);
+    }
+}
+
+/**
+ * Decompresses one frame produced by compressFrame
+ * @param data marker byte + payload
+ * @param frame PAGE_SIZE output bytes
+ */
+inline void decompressFrame(const std::vector<uint8_t> &data, int8_t *frame) {
+    uint8_t *output = reinterpret_cast<uint8_t *>(frame);
+    if (data[0] == STORED_MARKER) {
+        std::memcpy(output, data.data() + 1, PAGE_SIZE);
+        return;
+    }
+
+    size_t in = 1;
+    unsigned position = 0;
+    while (in < data.size() && position < PAGE_SIZE) {
+        uint8_t matchLength = data[in++];
+        if (matchLength == 0) {
+            uint8_t literalCount = data[in++];
+            std::memcpy(output + position, data.data() + in, literalCount);
+            in += literalCount;
+            position += literalCount;
+        } else {
+            uint8_t offset = data[in++];
+            // overlapping copies are legal (RLE-style matches)
+            for (unsigned i = 0; i < matchLength; i++) {
+                output[position + i] = output[position - offset + i];
+            }
+            position += matchLength;
+        }
+    }
+}
+
+} // namespace frame_codec
+
+/** @class CompressedVictimCache
+ *  @brief zram-style compressed cache between the frames and the store
+ *
+ * Evicted pages are compressed into a byte-budgeted pool instead of
+ * being dropped; a later fault checks here before paying the backing
+ * file's I/O cost and decompresses straight into the frame. When the
+ * pool overflows, the oldest victims fall out (they can still be
+ * re-read from the file). Hit/miss counters and the achieved
+ * compression ratio are appended to the replay statistics so the
+ * cache can be sized from data.
+ */
+class CompressedVictimCache {
+  private:
+    std::unordered_map<uint8_t, std::vector<uint8_t>> cache;
+    std::deque<uint8_t> insertionOrder;
+    size_t pooledBytes = 0;
+    size_t poolBudget;
+
+    // statistics
+    long hits = 0;
+    long misses = 0;
+    uint64_t rawBytes = 0;
+    uint64_t compressedBytes = 0;
+
+    std::vector<uint8_t> scratch;
+
+  public:
+    explicit CompressedVictimCache(size_t poolBudget = VICTIM_CACHE_DEFAULT_BYTES)
+        : poolBudget(poolBudget) {}
+
+    /**
+     * Compresses an evicted frame into the pool
+     * @param pageNumber evicted page
+     * @param frame the frame's contents at eviction time
+     */
+    void store(uint8_t pageNumber, const int8_t *frame) {
+        frame_codec::compressFrame(frame, scratch);
+        rawBytes += PAGE_SIZE;
+        compressedBytes += scratch.size();
+
+        auto existing = cache.find(pageNumber);
+        if (existing != cache.end()) {
+            pooledBytes -= existing->second.size();
+        } else {
+            insertionOrder.push_back(pageNumber);
+        }
+        pooledBytes += scratch.size();
+        cache[pageNumber] = scratch;
+
+        // oldest victims fall out once the pool overflows
+        while (pooledBytes > poolBudget && !insertionOrder.empty()) {
+            uint8_t oldest = insertionOrder.front();
+            insertionOrder.pop_front();
+            auto entry = cache.find(oldest);
+            if (entry != cache.end()) {
+                pooledBytes -= entry->second.size();
+                cache.erase(entry);
+            }
+        }
+    }
+
+    /**
+     * Serves a fault from the pool, if the page is cached
+     * @param pageNumber faulting page
+     * @param frame PAGE_SIZE output bytes on success
+     * @return true on a cache hit
+     */
+    bool load(uint8_t pageNumber, int8_t *frame) {
+        auto entry = cache.find(pageNumber);
+        if (entry == cache.end()) {
+            misses++;
+            return false;
+        }
+        hits++;
+        frame_codec::decompressFrame(entry->second, frame);
+        return true;
+    }
+
+    /**
+     * Empties the pool and the counters (next trace starts cold)
+     */
+    void reset() {
+        cache.clear();
+        insertionOrder.clear();
+        pooledBytes = 0;
+        hits = 0;
+        misses = 0;
+        rawBytes = 0;
+        compressedBytes = 0;
+    }
+
+    /**
+     * Formats the hit/miss and compression-ratio statistics, appended
+     * to the replay's standard statistics
+     */
+    std::string formatStats() const {
+        long lookups = hits + misses;
+        std::ostringstream stats;
+        stats << "Victim Cache Hit Rate = "
+              << (lookups > 0 ? 100.0 * hits / lookups : 0.0) << "%" << '\n';
+        stats << "Victim Cache Compression Ratio = "
+              << (compressedBytes > 0 ? static_cast<double>(rawBytes) / compressedBytes : 0.0)
+              << '\n';
+        return stats.str();
+    }
+};
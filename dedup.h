@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+
+#include "vmm_config.h"
+
+/** @class PageDeduplicator
+ *  @brief Content-based frame sharing with copy-on-write bookkeeping
+ *
+ * Identical backing pages no longer burn one frame each: the fault
+ * handler hashes each page's content as it loads and maps pages with
+ * identical bytes (hash match confirmed by a full compare when the
+ * bytes are at hand) to a single shared frame with a reference count.
+ * A page whose content hash is already memoized can skip the backing
+ * store read entirely on a re-fault - the shared frame is found from
+ * the memo alone.
+ *
+ * The write path breaks sharing with copy-on-write: storing to a
+ * frame referenced by several pages first copies it to a private
+ * frame for the writing page; a store to any deduplicated frame also
+ * retires its content-map entry, so diverged content can never be
+ * shared with a future fault. Statistics report mappings shared,
+ * reads avoided, and COW copies, so the effective capacity gain of
+ * the FRAMES budget is measurable.
+ */
+class PageDeduplicator {
+  private:
+    static constexpr uint64_t NO_HASH = ~uint64_t{0};
+
+    // content hash -> frame currently holding exactly that content
+    std::unordered_map<uint64_t, uint16_t> contentToFrame;
+
+    // per-frame state
+    std::array<uint16_t, FRAMES> refCount{};
+    std::array<uint64_t, FRAMES> frameHash{};
+
+    // per-page memo of the last loaded content hash
+    std::array<uint64_t, PAGE_TABLE_SIZE> pageHashMemo{};
+
+    // statistics
+    long sharedMappings = 0;
+    long readsAvoided = 0;
+    long cowCopies = 0;
+
+  public:
+    PageDeduplicator() {
+        frameHash.fill(NO_HASH);
+        pageHashMemo.fill(NO_HASH);
+    }
+
+    /** xxhash-style content hash of one page */
+    static uint64_t hashPage(const int8_t *pageData) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(pageData);
+        uint64_t hash = 0x9E3779B97F4A7C15ull;
+        for (unsigned i = 0; i < PAGE_SIZE; i += 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, bytes + i, 8);
+            hash ^= chunk;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+        }
+        return hash;
+    }
+
+    /**
+     * Re-fault shortcut: finds the shared frame for a page whose
+     * content hash is memoized, without touching the backing store
+     * @param pageNumber faulting page
+     * @param frameNumber receives the shared frame on success
+     * @return true when the page could be mapped from the memo alone
+     */
+    bool findByMemo(uint8_t pageNumber, uint16_t &frameNumber) {
+        uint64_t memo = pageHashMemo[pageNumber];
+        if (memo == NO_HASH)
+            return false;
+        auto entry = contentToFrame.find(memo);
+        if (entry == contentToFrame.end())
+            return false;
+        frameNumber = entry->second;
+        refCount[frameNumber]++;
+        sharedMappings++;
+        readsAvoided++;
+        return true;
+    }
+
+    /**
+     * Content match against the loaded bytes: share the holding frame
+     * if one exists (full byte compare guards against collisions)
+     * @param pageNumber faulting page
+     * @param pageData the page's freshly read bytes
+     * @param holderData accessor for a candidate frame's bytes
+     * @param frameNumber receives the shared frame on success
+     * @return true when an identical frame was found and shared
+     */
+    template <typename FrameBytes>
+    bool findByContent(uint8_t pageNumber, const int8_t *pageData, FrameBytes &&holderData,
+                       uint16_t &frameNumber) {
+        uint64_t hash = hashPage(pageData);
+        pageHashMemo[pageNumber] = hash;
+
+        auto entry = contentToFrame.find(hash);
+        if (entry == contentToFrame.end())
+            return false;
+        if (std::memcmp(holderData(entry->second), pageData, PAGE_SIZE) != 0)
+            return false; // hash collision: genuinely different bytes
+
+        frameNumber = entry->second;
+        refCount[frameNumber]++;
+        sharedMappings++;
+        return true;
+    }
+
+    /**
+     * Registers a freshly loaded (unshared) frame's content
+     */
+    void registerFrame(uint8_t pageNumber, uint16_t frameNumber) {
+        uint64_t hash = pageHashMemo[pageNumber];
+        refCount[frameNumber] = 1;
+        frameHash[frameNumber] = hash;
+        contentToFrame[hash] = frameNumber;
+    }
+
+    /** @return true when the frame is mapped by more than one page */
+    bool isShared(uint16_t frameNumber) const {
+        return refCount[frameNumber] > 1;
+    }
+
+    /**
+     * Copy-on-write bookkeeping: the writing page moved to its own
+     * private copy of the shared frame
+     */
+    void onCowCopy(uint8_t pageNumber, uint16_t sharedFrame, uint16_t privateFrame) {
+        refCount[sharedFrame]--;
+        refCount[privateFrame] = 1;
+        frameHash[privateFrame] = NO_HASH; // diverging, never shareable
+        pageHashMemo[pageNumber] = NO_HASH;
+        cowCopies++;
+    }
+
+    /**
+     * A store landed in this frame: its content diverged, retire the
+     * content-map entry so future faults cannot share stale bytes
+     */
+    void onFrameModified(uint16_t frameNumber) {
+        if (frameHash[frameNumber] != NO_HASH) {
+            contentToFrame.erase(frameHash[frameNumber]);
+            frameHash[frameNumber] = NO_HASH;
+        }
+    }
+
+    /**
+     * Clears all sharing state (next trace starts cold)
+     */
+    void reset() {
+        contentToFrame.clear();
+        refCount.fill(0);
+        frameHash.fill(NO_HASH);
+        pageHashMemo.fill(NO_HASH);
+        sharedMappings = 0;
+        readsAvoided = 0;
+        cowCopies = 0;
+    }
+
+    /**
+     * Formats the sharing statistics, appended to the replay's
+     * standard statistics
+     */
+    std::string formatStats() const {
+        std::ostringstream stats;
+        stats << "Deduplicated Mappings = " << sharedMappings << '\n';
+        stats << "Backing Store Reads Avoided = " << readsAvoided << '\n';
+        stats << "Copy-On-Write Copies = " << cowCopies << '\n';
+        return stats.str();
+    }
+};
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+/** @class EvictionPolicy
+ *  @brief Interface for frame replacement policies
+ *
+ * The allocator reports page loads and accesses; when no free frame is
+ * left the policy picks the victim. Implementations keep their own
+ * per-frame metadata and must be O(1) (amortized for CLOCK).
+ */
+class EvictionPolicy {
+  public:
+    virtual ~EvictionPolicy() = default;
+
+    /** A page was loaded into this frame */
+    virtual void onPageLoaded(uint16_t frameNumber) = 0;
+
+    /** The page resident in this frame was referenced */
+    virtual void onPageAccessed(uint16_t frameNumber) = 0;
+
+    /** Pick the frame to evict; only called when every frame is in use */
+    virtual uint16_t selectVictim() = 0;
+};
+
+/** @class FifoEvictionPolicy
+ *  @brief Evicts frames in load order, ignoring accesses
+ */
+class FifoEvictionPolicy : public EvictionPolicy {
+  private:
+    std::deque<uint16_t> loadOrder;
+
+  public:
+    void onPageLoaded(uint16_t frameNumber) override {
+        loadOrder.push_back(frameNumber);
+    }
+
+    void onPageAccessed(uint16_t) override {
+        // FIFO does not care about references
+    }
+
+    uint16_t selectVictim() override {
+        uint16_t frameNumber = loadOrder.front();
+        loadOrder.pop_front();
+        return frameNumber;
+    }
+};
+
+/** @class LruEvictionPolicy
+ *  @brief True LRU via an intrusive recency list over the frames
+ *
+ * Same intrusive-list technique as IndexedTLB: prev/next arrays
+ * indexed by frame number, head is the least recently used frame.
+ */
+class LruEvictionPolicy : public EvictionPolicy {
+  private:
+    std::vector<int32_t> prev;
+    std::vector<int32_t> next;
+    int32_t head = -1;
+    int32_t tail = -1;
+
+    void detach(int32_t frameNumber) {
+        if (prev[frameNumber] != -1)
+            next[prev[frameNumber]] = next[frameNumber];
+        else
+            head = next[frameNumber];
+        if (next[frameNumber] != -1)
+            prev[next[frameNumber]] = prev[frameNumber];
+        else
+            tail = prev[frameNumber];
+    }
+
+    void appendTail(int32_t frameNumber) {
+        prev[frameNumber] = tail;
+        next[frameNumber] = -1;
+        if (tail != -1)
+            next[tail] = frameNumber;
+        else
+            head = frameNumber;
+        tail = frameNumber;
+    }
+
+  public:
+    explicit LruEvictionPolicy(uint16_t frameCount)
+        : prev(frameCount, -1), next(frameCount, -1) {}
+
+    void onPageLoaded(uint16_t frameNumber) override {
+        appendTail(frameNumber);
+    }
+
+    void onPageAccessed(uint16_t frameNumber) override {
+        if (tail != frameNumber) {
+            detach(frameNumber);
+            appendTail(frameNumber);
+        }
+    }
+
+    uint16_t selectVictim() override {
+        uint16_t frameNumber = static_cast<uint16_t>(head);
+        detach(head);
+        return frameNumber;
+    }
+};
+
+/** @class ClockEvictionPolicy
+ *  @brief CLOCK (second chance): O(1) amortized, near-LRU quality
+ *
+ * One reference bit per frame, set on access; the hand sweeps the
+ * frames, clearing bits until it finds an unreferenced victim.
+ */
+class ClockEvictionPolicy : public EvictionPolicy {
+  private:
+    std::vector<uint8_t> referenced;
+    uint16_t frameCount;
+    uint16_t hand = 0;
+
+  public:
+    explicit ClockEvictionPolicy(uint16_t frameCount)
+        : referenced(frameCount, 0), frameCount(frameCount) {}
+
+    void onPageLoaded(uint16_t frameNumber) override {
+        referenced[frameNumber] = 1;
+    }
+
+    void onPageAccessed(uint16_t frameNumber) override {
+        referenced[frameNumber] = 1;
+    }
+
+    uint16_t selectVictim() override {
+        // sweep, granting each referenced frame its second chance
+        while (referenced[hand]) {
+            referenced[hand] = 0;
+            hand = (hand + 1) % frameCount;
+        }
+        uint16_t frameNumber = hand;
+        hand = (hand + 1) % frameCount;
+        return frameNumber;
+    }
+};
+
+/** @class FrameAllocator
+ *  @brief Manages a configurable frame budget with eviction
+ *
+ * Backs the limited-frame mode: hands out free frames from a free
+ * list until the budget is exhausted, then asks the configured
+ * EvictionPolicy for a victim. Keeps the frame -> page reverse map so
+ * the caller can invalidate the evicted page's PageTable and TLB
+ * entries directly instead of scanning.
+ */
+class FrameAllocator {
+  public:
+    /** Result of an allocation: the frame, and the page it displaced
+     *  (-1 when a free frame was used) */
+    struct Allocation {
+        uint16_t frameNumber;
+        int16_t evictedPage;
+    };
+
+  private:
+    uint16_t frameCount;
+    std::unique_ptr<EvictionPolicy> policy;
+
+    // reverse map: frame -> resident page, -1 -> free
+    std::vector<int16_t> frameToPage;
+
+    // free frames, kept so the lowest-numbered frame is handed out
+    // first (matches the historical nextAvailableFrame order)
+    std::vector<uint16_t> freeFrames;
+
+    // per-frame dirty bits, set by the store path and consumed (then
+    // cleared) by the eviction write-back
+    std::vector<uint8_t> dirtyBits;
+
+  public:
+    /**
+     * Constructor: build the free list and the configured policy
+     * @param frameCount frame budget (1..FRAMES)
+     * @param policyName one of "fifo", "lru", "clock"
+     *
+     * Terminate on an unknown policy name
+     */
+    FrameAllocator(uint16_t frameCount, const std::string &policyName)
+        : frameCount(frameCount), frameToPage(frameCount, -1), dirtyBits(frameCount, 0) {
+        freeFrames.reserve(frameCount);
+        for (uint16_t frame = frameCount; frame > 0; frame--) {
+            freeFrames.push_back(frame - 1);
+        }
+
+        if (policyName == "fifo") {
+            policy = std::make_unique<FifoEvictionPolicy>();
+        } else if (policyName == "lru") {
+            policy = std::make_unique<LruEvictionPolicy>(frameCount);
+        } else if (policyName == "clock") {
+            policy = std::make_unique<ClockEvictionPolicy>(frameCount);
+        } else {
+            std::cerr << "Unknown eviction policy: " << policyName << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /**
+     * Allocates a frame for a faulting page, evicting if necessary
+     * @param pageNumber page about to be loaded
+     * @return the frame plus the displaced page, if any
+     */
+    Allocation allocate(uint8_t pageNumber) {
+        Allocation allocation{};
+
+        if (!freeFrames.empty()) {
+            allocation.frameNumber = freeFrames.back();
+            freeFrames.pop_back();
+            allocation.evictedPage = -1;
+        } else {
+            allocation.frameNumber = policy->selectVictim();
+            allocation.evictedPage = frameToPage[allocation.frameNumber];
+        }
+
+        frameToPage[allocation.frameNumber] = pageNumber;
+        policy->onPageLoaded(allocation.frameNumber);
+        return allocation;
+    }
+
+    /** Marks a frame dirty (its page was stored to while resident) */
+    void markDirty(uint16_t frameNumber) {
+        dirtyBits[frameNumber] = 1;
+    }
+
+    /** @return true when the frame holds unwritten stores */
+    bool isDirty(uint16_t frameNumber) const {
+        return dirtyBits[frameNumber] != 0;
+    }
+
+    /** Clears a frame's dirty bit (its page was queued for write-back) */
+    void clearDirty(uint16_t frameNumber) {
+        dirtyBits[frameNumber] = 0;
+    }
+
+    /**
+     * Reports a reference to a resident frame (keeps LRU/CLOCK honest)
+     */
+    void onAccess(uint16_t frameNumber) {
+        policy->onPageAccessed(frameNumber);
+    }
+
+    uint16_t getFrameCount() const { return frameCount; }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <type_traits>
+#include <cstdint>
+
+/** @struct Geometry
+ *  @brief Compile-time simulator geometry policy
+ *
+ * Replaces the free-floating PAGE_SIZE/MASK/BITSHIFT macros: every
+ * mask, shift, and table size is *derived* from four parameters, so a
+ * configuration where the masks do not match the shifts cannot
+ * compile. Each deployed configuration is instantiated as its own
+ * executable (see CMakeLists.txt), keeping every constant a
+ * compile-time literal in the hot loop - no runtime geometry branches
+ * or divisions.
+ *
+ * @tparam VirtualBits_ virtual address width in bits
+ * @tparam PageBits_    log2 of the page (and frame) size
+ * @tparam FrameCount_  physical frames
+ * @tparam TlbEntries_  TLB capacity
+ */
+template <unsigned VirtualBits_, unsigned PageBits_, unsigned FrameCount_, unsigned TlbEntries_>
+struct Geometry {
+    static_assert(VirtualBits_ > PageBits_, "virtual space must exceed one page");
+    static_assert(VirtualBits_ <= 32, "addresses are carried in uint32 trace records");
+    static_assert(PageBits_ > 0 && FrameCount_ > 0 && TlbEntries_ > 0,
+                  "degenerate geometry");
+
+    static constexpr unsigned VIRTUAL_BITS = VirtualBits_;
+    static constexpr unsigned PAGE_SHIFT = PageBits_;
+
+    static constexpr uint32_t PAGE_BYTES = uint32_t{1} << PageBits_;
+    static constexpr uint32_t PAGE_COUNT = uint32_t{1} << (VirtualBits_ - PageBits_);
+    static constexpr uint32_t FRAME_BYTES = PAGE_BYTES; // frames mirror pages
+    static constexpr uint32_t FRAME_COUNT = FrameCount_;
+    static constexpr uint32_t TLB_ENTRIES = TlbEntries_;
+
+    // masks derived from the widths above - consistency is structural
+    static constexpr uint32_t ADDRESS_MASK =
+            VirtualBits_ >= 32 ? 0xFFFFFFFFu : (uint32_t{1} << VirtualBits_) - 1;
+    static constexpr uint32_t OFFSET_MASK = PAGE_BYTES - 1;
+
+    static_assert((ADDRESS_MASK >> PAGE_SHIFT) == PAGE_COUNT - 1,
+                  "mask/shift derivation is inconsistent");
+
+    // narrowest integer types that hold a page/frame number
+    using PageNumberType = std::conditional_t<
+            (PAGE_COUNT <= 256), uint8_t,
+            std::conditional_t<(PAGE_COUNT <= 65536), uint16_t, uint32_t>>;
+    using FrameNumberType = std::conditional_t<
+            (FRAME_COUNT <= 256), uint8_t,
+            std::conditional_t<(FRAME_COUNT <= 65536), uint16_t, uint32_t>>;
+};
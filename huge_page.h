@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "indexed_tlb.h"
+
+// small pages per huge page: 16 x 256 B = one 4 KiB huge page, the
+// two-size mix the translation path models
+#define HUGE_PAGE_SPAN 16
+#define HUGE_PAGE_SHIFT 4
+#define HUGE_PAGE_COUNT (PAGE_TABLE_SIZE / HUGE_PAGE_SPAN)
+
+/** @class HugePageTLB
+ *  @brief TLB supporting two page sizes simultaneously
+ *
+ * Models the small-page/huge-page trade-off: alongside a regular
+ * small-page TLB (the indexed O(1) implementation), a direct-mapped
+ * huge-page table holds entries that each cover HUGE_PAGE_SPAN small
+ * pages with a single slot - the way hardware 2 MiB entries relieve
+ * TLB pressure.
+ *
+ * Promotion is learned from the insert stream: the class tracks, per
+ * huge-page region, which small pages have been observed mapped and
+ * whether their frames are mutually contiguous (frame = base + offset
+ * within the region). The moment a region is fully resident and
+ * contiguous it is promoted to one huge entry; evicting (or remapping
+ * inconsistently) any covered small page demotes the region again.
+ * Lookups are answered from the huge table first - one array probe -
+ * and per-size hit counters feed the appended statistics, so the
+ * small/huge split is visible in every replay.
+ *
+ * The backing store and page table stay small-page granular: huge
+ * pages are a translation-path phenomenon here, exactly like TLB
+ * coalescing on real hardware.
+ */
+class HugePageTLB {
+  private:
+    struct HugeEntry {
+        bool valid = false;
+        uint8_t baseFrame = 0;
+    };
+
+    // direct-mapped huge entries, indexed by huge-page number
+    std::array<HugeEntry, HUGE_PAGE_COUNT> hugeEntries{};
+
+    // promotion tracking per huge-page region
+    struct RegionTracking {
+        int16_t expectedBase = -1;  // frame of small page 0, -1 unknown
+        uint16_t residentBitmap = 0; // which of the 16 small pages seen
+    };
+    std::array<RegionTracking, HUGE_PAGE_COUNT> regions{};
+
+    // regular small-page TLB behind the huge probe
+    IndexedTLB smallTlb;
+
+    // per-size counters for the appended statistics
+    long smallHits = 0;
+    long hugeHits = 0;
+    long misses = 0;
+    long promotions = 0;
+
+    static unsigned hugePage(uint8_t pageNumber) { return pageNumber >> HUGE_PAGE_SHIFT; }
+    static unsigned subPage(uint8_t pageNumber) { return pageNumber & (HUGE_PAGE_SPAN - 1); }
+
+  public:
+    /**
+     * Probes the huge table first, then the small TLB
+     * @param pageNumber the virtual (small) page number to lookup
+     * @return optional frame number on a hit at either size
+     */
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        const HugeEntry &hugeEntry = hugeEntries[hugePage(pageNumber)];
+        if (hugeEntry.valid) {
+            hugeHits++;
+            return static_cast<uint8_t>(hugeEntry.baseFrame + subPage(pageNumber));
+        }
+
+        std::optional<uint8_t> frameNumber = smallTlb.getFrameNumber(pageNumber);
+        if (frameNumber.has_value()) {
+            smallHits++;
+        } else {
+            misses++;
+        }
+        return frameNumber;
+    }
+
+    /**
+     * Inserts a small-page mapping and advances promotion tracking
+     * @param pageNumber virtual page number to add
+     * @param frameNumber corresponding physical frame number
+     */
+    void addEntry(uint8_t pageNumber, uint8_t frameNumber) {
+        smallTlb.addEntry(pageNumber, frameNumber);
+
+        RegionTracking &region = regions[hugePage(pageNumber)];
+        int16_t base = static_cast<int16_t>(frameNumber) - static_cast<int16_t>(subPage(pageNumber));
+        if (base < 0) {
+            // frames this low can never cover the region contiguously;
+            // demote any covering huge entry for the same reason as below
+            hugeEntries[hugePage(pageNumber)].valid = false;
+            region.expectedBase = -1;
+            region.residentBitmap = 0;
+            return;
+        }
+
+        if (region.residentBitmap == 0 || region.expectedBase != base) {
+            // first observation, or the region stopped being contiguous:
+            // restart tracking from this mapping, and demote any huge
+            // entry still covering the region - its base is stale now
+            // (e.g. a copy-on-write moved a covered page elsewhere)
+            hugeEntries[hugePage(pageNumber)].valid = false;
+            region.expectedBase = base;
+            region.residentBitmap = 0;
+        }
+        region.residentBitmap |= static_cast<uint16_t>(1u << subPage(pageNumber));
+
+        // fully resident and contiguous -> promote to one huge entry
+        if (region.residentBitmap == 0xFFFF && !hugeEntries[hugePage(pageNumber)].valid) {
+            hugeEntries[hugePage(pageNumber)] = {true, static_cast<uint8_t>(base)};
+            promotions++;
+        }
+    }
+
+    /**
+     * Drops a small page's mapping; a covering huge entry demotes,
+     * since its region is no longer fully resident
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint8_t pageNumber) {
+        smallTlb.invalidate(pageNumber);
+
+        unsigned region = hugePage(pageNumber);
+        hugeEntries[region].valid = false;
+        regions[region].residentBitmap &=
+                static_cast<uint16_t>(~(1u << subPage(pageNumber)));
+    }
+
+    /**
+     * Empties both sizes and the counters (next trace starts cold)
+     */
+    void reset() {
+        hugeEntries.fill(HugeEntry{});
+        regions.fill(RegionTracking{});
+        smallTlb.reset();
+        smallHits = 0;
+        hugeHits = 0;
+        misses = 0;
+        promotions = 0;
+    }
+
+    std::vector<std::pair<uint8_t, uint8_t>> snapshot() const {
+        // small entries carry the state; huge entries are re-learned
+        return smallTlb.snapshot();
+    }
+
+    void restore(const std::vector<std::pair<uint8_t, uint8_t>> &entries) {
+        reset();
+        for (const auto &[pageNumber, frameNumber] : entries) {
+            addEntry(pageNumber, frameNumber);
+        }
+    }
+
+    /**
+     * Formats the per-size hit split and promotion count, appended to
+     * the replay's standard statistics
+     */
+    std::string formatStats() const {
+        long lookups = smallHits + hugeHits + misses;
+        std::ostringstream stats;
+        stats << "Small-Page TLB Hit Rate = "
+              << (lookups > 0 ? 100.0 * smallHits / lookups : 0.0) << "%" << '\n';
+        stats << "Huge-Page TLB Hit Rate = "
+              << (lookups > 0 ? 100.0 * hugeHits / lookups : 0.0) << "%" << '\n';
+        stats << "Huge-Page Promotions = " << promotions << '\n';
+        return stats.str();
+    }
+};
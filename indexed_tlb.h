@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+/** @class IndexedTLB
+ *  @brief O(1) TLB with a page-number index and an intrusive LRU list
+ *
+ * Purpose: drop-in alternative to the deque-based TLB for large TLB
+ * sizes, where the linear scan dominates. Lookup goes through a
+ * direct-mapped index keyed by page number (the page number is 8 bits,
+ * so a flat array beats an open-addressing hash here), and recency is
+ * tracked with an intrusive doubly-linked list threaded through the
+ * entry slots - no erase/emplace churn on hit or insert.
+ *
+ * Replacement semantics match the deque version exactly: a hit moves
+ * the entry to the most-recent end, a full insert evicts the least
+ * recently used entry.
+ */
+class IndexedTLB {
+  private:
+    struct Entry {
+        uint8_t pageNumber;
+        uint8_t frameNumber;
+        // intrusive recency list links (slot indices, -1 -> none)
+        int16_t prev;
+        int16_t next;
+    };
+
+    // fixed entry storage; slots are handed out in order until full,
+    // slots released by invalidate() are recycled through freeSlots
+    std::array<Entry, TLB_SIZE> entries{};
+    int16_t usedSlots = 0;
+    std::vector<int16_t> freeSlots;
+
+    // direct-mapped index: page number -> slot, -1 -> not cached
+    std::array<int16_t, PAGE_TABLE_SIZE> index{};
+
+    // recency list: head -> least recently used, tail -> most recent
+    int16_t head = -1;
+    int16_t tail = -1;
+
+    // unlink a slot from the recency list
+    void detach(int16_t slot) {
+        Entry &entry = entries[slot];
+        if (entry.prev != -1)
+            entries[entry.prev].next = entry.next;
+        else
+            head = entry.next;
+        if (entry.next != -1)
+            entries[entry.next].prev = entry.prev;
+        else
+            tail = entry.prev;
+    }
+
+    // append a slot at the most-recent end of the list
+    void appendTail(int16_t slot) {
+        Entry &entry = entries[slot];
+        entry.prev = tail;
+        entry.next = -1;
+        if (tail != -1)
+            entries[tail].next = slot;
+        else
+            head = slot;
+        tail = slot;
+    }
+
+  public:
+    /**
+     * Constructor: mark every index entry as not cached
+     */
+    IndexedTLB() {
+        index.fill(-1);
+        // preallocate so invalidate()/addEntry never touch malloc
+        freeSlots.reserve(TLB_SIZE);
+    }
+
+    /**
+     * Searches for a page number in the TLB
+     * @param pageNumber the virtual page number to lookup
+     * @return optional frame number on TLB hit, empty otherwise
+     */
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        int16_t slot = index[pageNumber];
+        if (slot == -1)
+            return std::nullopt; // TLB miss
+
+        // LRU touch: move the slot to the most-recent end
+        if (tail != slot) {
+            detach(slot);
+            appendTail(slot);
+        }
+        return entries[slot].frameNumber;
+    }
+
+    /**
+     * This func adds a new entry to the TLB, while managing capacity
+     * @param pageNumber virtual page number to add
+     * @param frameNumber corresponding physical frame number
+     */
+    void addEntry(uint8_t pageNumber, uint8_t frameNumber) {
+        int16_t slot = index[pageNumber];
+        if (slot != -1) {
+            // already cached: refresh the mapping and the recency
+            entries[slot].frameNumber = frameNumber;
+            if (tail != slot) {
+                detach(slot);
+                appendTail(slot);
+            }
+            return;
+        }
+
+        if (!freeSlots.empty()) {
+            // recycle a slot released by invalidate()
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else if (usedSlots < TLB_SIZE) {
+            // still warming up: hand out the next free slot
+            slot = usedSlots++;
+        } else {
+            // full: evict the least recently used entry
+            slot = head;
+            detach(slot);
+            index[entries[slot].pageNumber] = -1;
+        }
+
+        entries[slot].pageNumber = pageNumber;
+        entries[slot].frameNumber = frameNumber;
+        index[pageNumber] = slot;
+        appendTail(slot);
+    }
+
+    /**
+     * Drops the entry for a page evicted from physical memory
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint8_t pageNumber) {
+        int16_t slot = index[pageNumber];
+        if (slot == -1)
+            return;
+
+        detach(slot);
+        index[pageNumber] = -1;
+        freeSlots.push_back(slot);
+    }
+
+    /**
+     * Empties the TLB (next trace in a batch starts cold)
+     */
+    void reset() {
+        index.fill(-1);
+        freeSlots.clear();
+        usedSlots = 0;
+        head = -1;
+        tail = -1;
+    }
+
+    /**
+     * @return cached entries in recency order, oldest first
+     */
+    std::vector<std::pair<uint8_t, uint8_t>> snapshot() const {
+        std::vector<std::pair<uint8_t, uint8_t>> result;
+        // walk the recency list from least to most recent
+        for (int16_t slot = head; slot != -1; slot = entries[slot].next) {
+            result.emplace_back(entries[slot].pageNumber, entries[slot].frameNumber);
+        }
+        return result;
+    }
+
+    /**
+     * Rebuilds the TLB from a snapshot (oldest entry first)
+     */
+    void restore(const std::vector<std::pair<uint8_t, uint8_t>> &entries) {
+        reset();
+        for (const auto &[pageNumber, frameNumber] : entries) {
+            addEntry(pageNumber, frameNumber);
+        }
+    }
+};
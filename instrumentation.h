@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Opt-in hot-path instrumentation. Compiled out to nothing unless the
+ * build defines VMM_INSTRUMENT (cmake -DVMM_INSTRUMENT=ON): every
+ * record/timer call is guarded by `if constexpr` on the flag, so the
+ * disabled build carries zero cost - no branches, no counters, no
+ * timer reads.
+ *
+ * When enabled, each pipeline stage records its per-operation duration
+ * (rdtsc ticks on x86-64, steady_clock nanoseconds elsewhere) into a
+ * preallocated log2-bucketed histogram, and the run ends by dumping a
+ * machine-readable JSON report next to the usual statistics.
+ */
+
+/** Pipeline stages tracked by the instrumentation layer */
+enum class Stage {
+    TlbLookup = 0,
+    PageTableLookup,
+    BackingStoreRead,
+    MemoryAccess,
+    OutputEmit,
+    StageCount
+};
+
+/** @class Instrumentation
+ *  @brief Preallocated per-stage log2 latency histograms
+ */
+class Instrumentation {
+  public:
+    static constexpr bool enabled =
+#ifdef VMM_INSTRUMENT
+            true;
+#else
+            false;
+#endif
+
+    static constexpr int STAGE_COUNT = static_cast<int>(Stage::StageCount);
+    static constexpr int BUCKET_COUNT = 64; // log2 buckets cover any uint64 duration
+
+  private:
+    std::array<std::array<uint64_t, BUCKET_COUNT>, STAGE_COUNT> histograms{};
+    std::array<uint64_t, STAGE_COUNT> counts{};
+    std::array<uint64_t, STAGE_COUNT> totals{};
+
+    static constexpr const char *stageNames[STAGE_COUNT] = {
+            "tlb_lookup", "page_table_lookup", "backing_store_read",
+            "memory_access", "output_emit"};
+
+  public:
+    /** Process-wide instance (the simulator is one pipeline) */
+    static Instrumentation &instance() {
+        static Instrumentation singleton;
+        return singleton;
+    }
+
+    /** Current timestamp in the cheapest monotonic unit available */
+    static uint64_t now() {
+        if constexpr (!enabled)
+            return 0;
+#if defined(__x86_64__) || defined(_M_X64)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(
+                std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /** Records one operation's duration for a stage */
+    void record(Stage stage, uint64_t ticks) {
+        if constexpr (!enabled)
+            return;
+        int bucket = ticks == 0 ? 0 : 64 - __builtin_clzll(ticks);
+        if (bucket >= BUCKET_COUNT)
+            bucket = BUCKET_COUNT - 1;
+        int index = static_cast<int>(stage);
+        histograms[index][bucket]++;
+        counts[index]++;
+        totals[index] += ticks;
+    }
+
+    /**
+     * Dumps the histograms as JSON
+     * @param fileName report path (e.g. instrumentation.json)
+     */
+    void writeReport(const std::string &fileName) {
+        if constexpr (!enabled)
+            return;
+
+        std::ofstream report(fileName);
+        if (!report) {
+            std::cerr << "Error opening instrumentation report: " << fileName << std::endl;
+            return;
+        }
+
+        report << "{\n";
+#if defined(__x86_64__) || defined(_M_X64)
+        report << "  \"timer\": \"rdtsc\",\n";
+#else
+        report << "  \"timer\": \"steady_clock_ns\",\n";
+#endif
+        report << "  \"stages\": [\n";
+        for (int index = 0; index < STAGE_COUNT; index++) {
+            report << "    {\"name\": \"" << stageNames[index] << "\", \"count\": "
+                   << counts[index] << ", \"total_ticks\": " << totals[index]
+                   << ", \"log2_buckets\": [";
+            // trim trailing empty buckets to keep the report readable
+            int lastBucket = BUCKET_COUNT - 1;
+            while (lastBucket > 0 && histograms[index][lastBucket] == 0)
+                lastBucket--;
+            for (int bucket = 0; bucket <= lastBucket; bucket++) {
+                if (bucket > 0)
+                    report << ", ";
+                report << histograms[index][bucket];
+            }
+            report << "]}" << (index + 1 < STAGE_COUNT ? "," : "") << "\n";
+        }
+        report << "  ]\n}\n";
+    }
+};
+
+/** @class ScopedStageTimer
+ *  @brief RAII timer recording one operation for one stage
+ *
+ * Collapses to an empty object in non-instrumented builds.
+ */
+class ScopedStageTimer {
+  private:
+    Stage stage;
+    uint64_t start;
+
+  public:
+    explicit ScopedStageTimer(Stage stage) : stage(stage), start(Instrumentation::now()) {}
+
+    ~ScopedStageTimer() {
+        if constexpr (Instrumentation::enabled) {
+            Instrumentation::instance().record(stage, Instrumentation::now() - start);
+        }
+    }
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+// open-addressing table sized at twice the frame count (power of two)
+// so probe chains stay short at full residency
+#define INVERTED_TABLE_SLOTS (FRAMES * 2)
+
+/** @class InvertedPageTable
+ *  @brief Frame-proportional page table for sparse address spaces
+ *
+ * The flat table spends one entry per *virtual* page, which explodes
+ * with the address-space size; this one spends one entry per physical
+ * frame plus a fixed open-addressing hash keyed by (process id, page
+ * number) for the reverse lookup, so memory scales with FRAMES no
+ * matter how large the virtual space grows. Linear probing with
+ * tombstones; the table never exceeds FRAMES live entries (one per
+ * frame), so at table size 2*FRAMES the load factor is bounded at 0.5.
+ *
+ * Drop-in behind the same getFrameNumber/setFrameNumber/invalidate
+ * interface as PageTable and the radix adapter (--page-table=inverted),
+ * and measurable against both in vmm_bench.
+ */
+class InvertedPageTable {
+  private:
+    // slot keys: (processId << 16) | pageNumber, with two sentinels
+    static constexpr uint64_t EMPTY_KEY = ~uint64_t{0};
+    static constexpr uint64_t TOMBSTONE_KEY = ~uint64_t{0} - 1;
+
+    struct Slot {
+        uint64_t key = EMPTY_KEY;
+        uint8_t frameNumber = 0;
+    };
+
+    std::array<Slot, INVERTED_TABLE_SLOTS> slots{};
+    uint32_t processId;
+    size_t tombstoneCount = 0;
+
+    /**
+     * Rebuilds the table without tombstones. Triggered when they
+     * cover a quarter of the slots, which keeps EMPTY terminators
+     * plentiful - a probe chain can therefore never wrap the table.
+     */
+    void rebuild() {
+        std::array<Slot, INVERTED_TABLE_SLOTS> live = slots;
+        slots.fill(Slot{});
+        tombstoneCount = 0;
+        for (const Slot &slot : live) {
+            if (slot.key != EMPTY_KEY && slot.key != TOMBSTONE_KEY) {
+                size_t at = hashKey(slot.key);
+                while (slots[at].key != EMPTY_KEY) {
+                    at = (at + 1) & (INVERTED_TABLE_SLOTS - 1);
+                }
+                slots[at] = slot;
+            }
+        }
+    }
+
+    static uint64_t makeKey(uint32_t processId, uint8_t pageNumber) {
+        return (static_cast<uint64_t>(processId) << 16) | pageNumber;
+    }
+
+    /** xxhash-style avalanche spreads the key over the slot space */
+    static size_t hashKey(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        return static_cast<size_t>(key) & (INVERTED_TABLE_SLOTS - 1);
+    }
+
+  public:
+    explicit InvertedPageTable(uint32_t processId = 0) : processId(processId) {}
+
+    /**
+     * Fetches the frame number for a given page
+     * @param pageNumber virtual page number to lookup
+     * @return optional frame number or empty in case of page fault
+     */
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        uint64_t key = makeKey(processId, pageNumber);
+        size_t slot = hashKey(key);
+        // linear probe; an EMPTY slot ends the chain, TOMBSTONEs do not
+        while (slots[slot].key != EMPTY_KEY) {
+            if (slots[slot].key == key)
+                return slots[slot].frameNumber;
+            slot = (slot + 1) & (INVERTED_TABLE_SLOTS - 1);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Updates the table with a new page <> frame mapping
+     * @param pageNumber virtual page number
+     * @param frameNumber physical frame number
+     */
+    void setFrameNumber(uint8_t pageNumber, uint8_t frameNumber) {
+        uint64_t key = makeKey(processId, pageNumber);
+        size_t slot = hashKey(key);
+        size_t insertAt = INVERTED_TABLE_SLOTS; // first reusable tombstone
+
+        while (slots[slot].key != EMPTY_KEY) {
+            if (slots[slot].key == key) {
+                slots[slot].frameNumber = frameNumber; // remap in place
+                return;
+            }
+            if (slots[slot].key == TOMBSTONE_KEY && insertAt == INVERTED_TABLE_SLOTS) {
+                insertAt = slot;
+            }
+            slot = (slot + 1) & (INVERTED_TABLE_SLOTS - 1);
+        }
+
+        if (insertAt == INVERTED_TABLE_SLOTS) {
+            insertAt = slot;
+        } else {
+            tombstoneCount--; // reusing a tombstone
+        }
+        slots[insertAt].key = key;
+        slots[insertAt].frameNumber = frameNumber;
+    }
+
+    /**
+     * Drops a mapping when its page is evicted from physical memory
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint8_t pageNumber) {
+        uint64_t key = makeKey(processId, pageNumber);
+        size_t slot = hashKey(key);
+        while (slots[slot].key != EMPTY_KEY) {
+            if (slots[slot].key == key) {
+                slots[slot].key = TOMBSTONE_KEY; // keep probe chains intact
+                tombstoneCount++;
+                if (tombstoneCount > INVERTED_TABLE_SLOTS / 4) {
+                    rebuild();
+                }
+                return;
+            }
+            slot = (slot + 1) & (INVERTED_TABLE_SLOTS - 1);
+        }
+    }
+
+    /**
+     * Drops every mapping (next trace in a batch starts cold)
+     */
+    void reset() {
+        slots.fill(Slot{});
+        tombstoneCount = 0;
+    }
+};
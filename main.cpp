@@ -1,321 +1,757 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
-#include <deque>
-#include <array>
 #include <string>
 #include <iomanip>
 #include <cstdint>
-#include <optional>
-#include <algorithm>
-
-#define PAGE_TABLE_SIZE 256 // max number of pages in the virtual mem
-#define PAGE_SIZE 256       // size of each page in bytes
-#define TLB_SIZE 16         // buffer size
-#define FRAME_SIZE 256      // size of each physical mem frame
-#define FRAMES 256          // total frames in the physical mem
-#define BITSHIFT 8
-#define MASK 0xFFFF      // mask to extract the lower 16 bits from the logical address
-#define OFFSET_MASK 0xFF // mask to extract the lowest 8 bits from logical address
 
-using namespace std;
+#include "vmm_config.h"
+#include "binary_trace.h"
+#include "trace_reader.h"
+#include "tlb.h"
+#include "indexed_tlb.h"
+#include "tlb_hierarchy.h"
+#include "tlb_policy.h"
+#include "huge_page.h"
+#include "page_table.h"
+#include "radix_page_table.h"
+#include "inverted_page_table.h"
+#include "packed_meta.h"
+#include "physical_memory.h"
+#include "backing_store.h"
+#include "translation_engine.h"
+#include "write_back.h"
+#include "parallel_replay.h"
+#include "page_server.h"
+#include "output_writer.h"
+#include "instrumentation.h"
+#include "checksum.h"
+#include "async_fault.h"
+#include "compressed_cache.h"
+#include "telemetry.h"
+#include "dedup.h"
 
+using namespace std;
 
-/** @class TLB
- *  @brief Translational Lookaside Buffer implementation
- *
- * Purpose: To provide a fast cache for page number to frame number translation
- *
+/**
+ * Replays a batch of address traces through the batched pipeline
+ * @tparam TlbType TLB implementation to translate through
+ * @param traceFiles address traces, replayed in order through the
+ *        same engine with an O(1) state reset between files
+ * @param frameBudget frame count for limited-frame mode, 0 -> all FRAMES
+ * @param evictionPolicy replacement policy name for limited-frame mode
+ * @param readaheadPages backing-store readahead depth (0 -> off)
+ * @param useMmap false forces the streamed (seekg/read) store
+ * @return process exit code
  */
-class TLB {
-  private:
-    // internal storage for TLB entries
-    // using deque to facilitate FIFO replacement strategy
-    // entry -> pair of <page number, frame number>
-    std::deque<std::pair<uint8_t, uint8_t>> tlbEntries;
-
-  public:
-    /**
-     * Searches for a page number in the TLB
-     * @param pageNumber the virtual page number to lookup
-     * @return optional frame number on TLB hit, empty otherwise
-     */
-    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
-        // iterate through the TLB to find a matching page number
-        for (auto iterator = tlbEntries.begin(); iterator != tlbEntries.end(); ++iterator) {
-            if (iterator->first == pageNumber) {
-                // got it, capture frame
-                uint8_t frameNumber = iterator->second;
-
-                // remove current entry and add it to the back
-                // make it work like LRU
-                tlbEntries.erase(iterator);
-                tlbEntries.emplace_back(pageNumber, frameNumber);
-                return frameNumber;
-            }
-        }
-        return std::nullopt; // TLB miss
+template <typename TlbType, typename PageTableType = PageTable>
+int runReplay(const std::vector<std::string> &traceFiles, bool quiet,
+              unsigned frameBudget, const std::string &evictionPolicy,
+              unsigned readaheadPages, bool useMmap,
+              const std::string &saveStateFile, const std::string &loadStateFile,
+              bool streamTraces, bool pageStatsReport, bool verifyMode,
+              bool useAsyncFaults, size_t victimCacheBytes,
+              double telemetrySeconds, uint16_t telemetryPort, bool dedupPages) {
+    TlbType tlb;
+    PageTableType pageTable;
+    PhysicalMemory physicalMemory;
+    BackingStore backingStore("BACKING_STORE.bin", useMmap);
+    backingStore.setReadahead(readaheadPages);
+
+    // limited-frame mode: a frame budget below FRAMES brings the
+    // FrameAllocator (and its eviction policy) into the fault path
+    std::optional<FrameAllocator> frameAllocator;
+    std::optional<WriteBackEngine> writeBack;
+    if (frameBudget > 0) {
+        frameAllocator.emplace(static_cast<uint16_t>(frameBudget), evictionPolicy);
+        // dirty evicted pages drain to the store through the
+        // coalescing background writer
+        writeBack.emplace(backingStore);
     }
 
-    /**
-     * This func adds a new entry to the TLB, while managing capacity
-     * @param pageNumber virtual page number to add
-     * @param frameNumber corresponding physical frame number
-     */
-    void addEntry(uint8_t pageNumber, uint8_t frameNumber) {
+    // opt-in heat-map accounting; the hot path pays nothing without it
+    std::optional<PageStatsEngine> pageStats;
+    if (pageStatsReport) {
+        pageStats.emplace();
+    }
 
-        // remove any existing entry for the same page to prevent duplicates
-        auto iterator = std::find_if(tlbEntries.begin(), tlbEntries.end(),
-                                     [&](const auto &entry) { return entry.first == pageNumber; });
-        if (iterator != tlbEntries.end()) {
-            tlbEntries.erase(iterator);
-        }
+    // overlapped fault servicing (streamed store only; the mapped
+    // store's alias path has no read to overlap)
+    std::optional<AsyncFaultEngine> asyncFaultEngine;
+    if (useAsyncFaults && !backingStore.isMapped()) {
+        asyncFaultEngine.emplace("BACKING_STORE.bin");
+    }
 
-        // enforce TLB size limit using FIFO
-        if (tlbEntries.size() >= TLB_SIZE) {
-            tlbEntries.pop_front(); // nuke the oldest entry
-        }
+    // compressed victim cache: only meaningful when eviction exists
+    std::optional<CompressedVictimCache> victimCache;
+    if (victimCacheBytes > 0 && frameBudget > 0) {
+        victimCache.emplace(victimCacheBytes);
+    }
 
-        // add new entry to the end of queue
-        tlbEntries.emplace_back(pageNumber, frameNumber);
+    // content-based frame sharing with copy-on-write
+    std::optional<PageDeduplicator> dedup;
+    if (dedupPages) {
+        dedup.emplace();
     }
-};
 
-/** @class PageTable
- *  @brief Manages virtual-to-physical memory mapping
- */
-class PageTable {
-  private:
-    // stores frame numbers, with -1 -> invalid/unloaded page
-    std::array<int16_t, PAGE_TABLE_SIZE> pageTable{};
-
-  public:
-    /**
-     * Constructor: initialize all entries as invalid (-1)
-     */
-    PageTable() {
-        pageTable.fill(-1);
-    }
-
-    /**
-     * Fetches the frame number for a given page
-     * @param pageNumber virtual page number to lookup
-     * @return optional frame number or empty in case of page fault
-     */
-    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
-        int16_t frameNumber = pageTable[pageNumber];
-        if (frameNumber != -1)
-            return static_cast<uint8_t>(frameNumber);
-        return std::nullopt;
-    }
-
-    /**
-     * Updates page table with a new page <> frame mapping
-     * @param pageNumber virtual page number
-     * @param frameNumber physical frame number
-     */
-    void setFrameNumber(uint8_t pageNumber, uint8_t frameNumber) {
-        pageTable[pageNumber] = frameNumber;
-    }
-};
-
-/** @class PhysicalMemory
- *  @brief Simulates physical memory organization
- */
-class PhysicalMemory {
-  private:
-    // 2D array to represent physical memory frames
-    // each frame -> fixed size array of bytes
-    std::array<std::array<int8_t, FRAME_SIZE>, FRAMES> memory{}; // Memory frames
-  public:
-    /**
-     *  Loads a complete page into a specific memory frame
-     * @param frameNumber target frame to load the page into
-     * @param pageData pointer of the source pageData
-     */
-    void loadPage(uint8_t frameNumber, const int8_t *pageData) {
-        std::copy_n(pageData, FRAME_SIZE, memory[frameNumber].begin());
-    }
-
-    /**
-     * Retrieves single byte from a specific physicalAddress
-     * @param physicalAddress fully translated memory address
-     * @return byte value of the specified address
-     *
-     * Translation:
-     *  high order bits -> frame number
-     *  low order bits -> offset within the frame
-     */
-    int8_t getValue(uint16_t physicalAddress) const {
-        uint8_t frameNumber = (physicalAddress >> 8) & 0xFF;
-        uint8_t offset = physicalAddress & 0xFF;
-        return memory[frameNumber][offset];
-    }
-};
-
-/** @class BackingStore
- *  @brief Simulates secondary storage for page loading
- *
- */
-class BackingStore {
-  private:
-    std::ifstream backingStoreFile;
-
-  public:
-    /**
-     * Constructor: Open BACKING_STORE.bin file
-     * @param fileName path to the BACKING_STORE.bin file
-     *
-     * Terminate if file cannot be opened
-     */
-    explicit BackingStore(const std::string &fileName) {
-        backingStoreFile.open(fileName, std::ios::binary);
-        if (!backingStoreFile) {
-            std::cerr << "Error opening backing store file: " << fileName << std::endl;
-            exit(EXIT_FAILURE);
-        }
+    TranslationEngine<TlbType, PageTableType> engine(
+            tlb, pageTable, physicalMemory, backingStore,
+            frameAllocator.has_value() ? &*frameAllocator : nullptr,
+            writeBack.has_value() ? &*writeBack : nullptr,
+            pageStats.has_value() ? &*pageStats : nullptr,
+            asyncFaultEngine.has_value() ? &*asyncFaultEngine : nullptr,
+            victimCache.has_value() ? &*victimCache : nullptr,
+            dedup.has_value() ? &*dedup : nullptr);
+
+    // verify mode computes a streaming digest and never touches the
+    // full-text output path at all
+    std::optional<OutputWriter> outputWriter;
+    if (!verifyMode) {
+        outputWriter.emplace("correct.txt", quiet);
     }
+    ReplayChecksum checksum;
 
-    /**
-     * Destructor: Ensure file is closed
-     */
-    ~BackingStore() {
-        if (backingStoreFile.is_open()) {
-            backingStoreFile.close();
-        }
+    // experiments start from a warm checkpoint in one read instead of
+    // re-simulating the whole warmup trace
+    if (!loadStateFile.empty() && !engine.loadState(loadStateFile)) {
+        std::cerr << "Error loading state file: " << loadStateFile << std::endl;
+        return EXIT_FAILURE;
     }
 
-    /**
-     * Read a specific page from the backing store
-     * @param pageNumber page to fetch
-     * @param buffer output buffer to store the page contents
-     */
-    void readPage(uint8_t pageNumber, int8_t *buffer) {
-        backingStoreFile.clear(); // Clear any error flags
-        backingStoreFile.seekg(pageNumber * PAGE_SIZE, std::ios::beg);
-        backingStoreFile.read(reinterpret_cast<char *>(buffer), 256);
+    // live progress telemetry: a dedicated thread snapshots the
+    // engine's (atomic) counters; the hot loop is never touched
+    std::optional<TelemetryServer> telemetry;
+    if (telemetrySeconds > 0.0) {
+        telemetry.emplace(
+                [&engine] {
+                    TelemetrySample sample;
+                    sample.totalAddresses = engine.getTotalAddresses();
+                    sample.tlbHits = engine.getTlbHits();
+                    sample.pageFaults = engine.getPageFaults();
+                    return sample;
+                },
+                telemetrySeconds, telemetryPort);
+    }
+
+    std::vector<TranslationResult> results(BATCH_SIZE);
+
+    // a batch of traces replays through the same warm objects: state
+    // is rewound between files (an O(1) arena/array reset), never
+    // torn down and rebuilt
+    for (size_t traceIndex = 0; traceIndex < traceFiles.size(); traceIndex++) {
+        const std::string &addressFileName = traceFiles[traceIndex];
+
+        if (traceIndex > 0) {
+            engine.resetForNextTrace();
+            if (frameAllocator.has_value()) {
+                frameAllocator.emplace(static_cast<uint16_t>(frameBudget), evictionPolicy);
+            }
+            if (victimCache.has_value()) {
+                victimCache->reset();
+            }
+        }
+
+        if (isBinaryTrace(addressFileName) && streamTraces) {
+            // streaming path: a background thread fills the next 4 MiB
+            // block while this one is translated, so cold-cache trace
+            // ingest overlaps with the pipeline
+            StreamingTraceReader reader(addressFileName);
+            std::span<const uint32_t> records;
+            while (!(records = reader.nextBlock()).empty()) {
+                for (size_t offset = 0; offset < records.size(); offset += BATCH_SIZE) {
+                    size_t count = std::min<size_t>(BATCH_SIZE, records.size() - offset);
+
+                    if (!engine.translateBatch(records.subspan(offset, count), results)) {
+                        std::cerr << "Error: Physical memory is full." << std::endl;
+                        return EXIT_FAILURE;
+                    }
+
+                    if (verifyMode) {
+                        checksum.addBatch(results.data(), count);
+                    } else {
+                        outputWriter->writeResults(results.data(), count);
+                    }
+                }
+            }
+        } else if (isBinaryTrace(addressFileName)) {
+            // binary path: the trace is mmap'd and batches are carved
+            // straight out of the mapping - no parsing, no copies
+            BinaryTraceFile trace(addressFileName);
+            std::span<const uint32_t> records = trace.records();
+            if (telemetry.has_value()) {
+                telemetry->setExpectedTotal(static_cast<long>(records.size()));
+            }
+
+            for (size_t offset = 0; offset < records.size(); offset += BATCH_SIZE) {
+                size_t count = std::min<size_t>(BATCH_SIZE, records.size() - offset);
+
+                if (!engine.translateBatch(records.subspan(offset, count), results)) {
+                    std::cerr << "Error: Physical memory is full." << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                if (verifyMode) {
+                    checksum.addBatch(results.data(), count);
+                } else {
+                    outputWriter->writeResults(results.data(), count);
+                }
+            }
+        } else {
+            std::ifstream addressFile(addressFileName);
+            if (!addressFile) {
+                std::cerr << "Error opening address file: " << addressFileName << std::endl;
+                return EXIT_FAILURE;
+            }
 
-        if (!backingStoreFile) {
-            std::cerr << "Error reading page from backing store" << std::endl;
-            exit(EXIT_FAILURE);
+            // batch buffers, reused for every block of the trace
+            std::vector<uint32_t> batch;
+            batch.reserve(BATCH_SIZE);
+
+            // parse stage: fill a batch of raw addresses, then push the whole
+            // block through the pipeline before touching the output streams
+            std::string line;
+            bool more = true;
+            while (more) {
+                batch.clear();
+                while (batch.size() < BATCH_SIZE && (more = static_cast<bool>(std::getline(addressFile, line)))) {
+                    // convert string to 32-bit unsigned int and mask to
+                    // the virtual address width before flagging stores -
+                    // a raw decimal >= 2^31 must not smuggle in the
+                    // write bit; a trailing " W" marks a store
+                    uint32_t record = static_cast<uint32_t>(std::stoul(line)) & MASK;
+                    if (line.find('W') != std::string::npos) {
+                        record |= TRACE_WRITE_BIT;
+                    }
+                    batch.push_back(record);
+                }
+                if (batch.empty())
+                    break;
+
+                if (!engine.translateBatch(batch, results)) {
+                    std::cerr << "Error: Physical memory is full." << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                if (verifyMode) {
+                    checksum.addBatch(results.data(), batch.size());
+                } else {
+                    outputWriter->writeResults(results.data(), batch.size());
+                }
+            }
+        }
+
+        if (verifyMode) {
+            // one digest line and the aggregate rates; no text output
+            std::cout << "Replay Digest = 0x" << std::hex << std::setw(16)
+                      << std::setfill('0') << checksum.getDigest() << std::dec
+                      << std::setfill(' ') << std::endl;
+            double pageFaultRate = 100.0 * engine.getPageFaults() / engine.getTotalAddresses();
+            double tlbHitRate = 100.0 * engine.getTlbHits() / engine.getTotalAddresses();
+            std::cout << "Page Fault Rate = " << pageFaultRate << "%" << std::endl;
+            std::cout << "TLB Hit Rate = " << tlbHitRate << "%" << std::endl;
+            checksum.reset();
+        } else {
+            outputWriter->writeStats(engine.getTotalAddresses(),
+                                     engine.getTlbHits(), engine.getPageFaults());
+
+            // TLB implementations with their own report (per-level rates,
+            // cycle estimates) append it to the standard statistics
+            if constexpr (requires { tlb.formatStats(); }) {
+                outputWriter->writeText(tlb.formatStats());
+            }
+            if (victimCache.has_value()) {
+                outputWriter->writeText(victimCache->formatStats());
+            }
+            if (dedup.has_value()) {
+                outputWriter->writeText(dedup->formatStats());
+            }
         }
     }
-};
 
-int main(int argc, char *argv[]) {
-    // validate cmd line args
-    if (argc != 2) {
-        std::cerr << "Usage: ./a.out addresses.txt" << std::endl;
+    if (pageStats.has_value()) {
+        pageStats->writeReport("page_stats.csv");
+    }
+
+    if (!saveStateFile.empty() && !engine.saveState(saveStateFile)) {
+        std::cerr << "Error saving state file: " << saveStateFile << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::string addressFileName = argv[1];
+    // instrumented builds drop their per-stage histograms next to the stats
+    Instrumentation::instance().writeReport("instrumentation.json");
 
-    TLB tlb;
-    PageTable pageTable;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Replays a whole address trace across worker threads
+ * @tparam TlbType TLB implementation, one private instance per worker
+ * @param addressFileName path of the address trace to replay
+ * @param threadCount number of worker threads
+ * @return process exit code
+ */
+template <typename TlbType>
+int runParallelReplay(const std::string &addressFileName, unsigned threadCount, bool quiet,
+                      bool verifyMode, double telemetrySeconds, uint16_t telemetryPort) {
+    SharedPageTable pageTable;
     PhysicalMemory physicalMemory;
     BackingStore backingStore("BACKING_STORE.bin");
 
-    std::ifstream addressFile(addressFileName);
-    if (!addressFile) {
-        std::cerr << "Error opening address file: " << addressFileName << std::endl;
-        return EXIT_FAILURE;
+    ParallelReplayEngine<TlbType> engine(pageTable, physicalMemory, backingStore, threadCount);
+
+    // live progress telemetry: the stats thread sums the per-worker
+    // padded counters (relaxed atomics) while the workers run
+    std::optional<TelemetryServer> telemetry;
+    if (telemetrySeconds > 0.0) {
+        telemetry.emplace(
+                [&engine] {
+                    TelemetrySample sample;
+                    sample.totalAddresses = engine.getTotalAddresses();
+                    sample.tlbHits = engine.getTlbHits();
+                    sample.pageFaults = engine.getPageFaults();
+                    return sample;
+                },
+                telemetrySeconds, telemetryPort);
     }
 
-    uint16_t nextAvailableFrame = 0;
-    int totalAddresses = 0;
-    int tlbHits = 0;
-    int pageFaults = 0;
+    std::optional<OutputWriter> outputWriter;
+    if (!verifyMode) {
+        outputWriter.emplace("correct.txt", quiet);
+    }
 
-    // processing each logical address
-    std::string line;
+    // parallel mode ingests the whole trace up front so it can be
+    // partitioned into per-worker slices; a binary trace is simply
+    // mapped and sliced in place
+    std::optional<BinaryTraceFile> binaryTrace;
+    std::vector<uint32_t> addresses;
+    std::span<const uint32_t> records;
+
+    if (isBinaryTrace(addressFileName)) {
+        binaryTrace.emplace(addressFileName);
+        records = binaryTrace->records();
+    } else {
+        std::ifstream addressFile(addressFileName);
+        if (!addressFile) {
+            std::cerr << "Error opening address file: " << addressFileName << std::endl;
+            return EXIT_FAILURE;
+        }
 
-    std::ofstream outputFile("correct.txt");
-    if (!outputFile) {
-        std::cerr << "Error opening correct.txt file: " << std::endl;
-        return EXIT_FAILURE;
+        std::string line;
+        while (std::getline(addressFile, line)) {
+            addresses.push_back(std::stoul(line));
+        }
+        records = addresses;
     }
 
-    while (std::getline(addressFile, line)) {
-        totalAddresses++;
-
-        // convert string to 32-bit unsigned int
-        // ensure that we are working with 16-bit logical address
-        // extract the lower 16 bits of the logical address using 0xFFFF ('1' * 16 in bin)
-        uint32_t logicalAddress = std::stoul(line) & MASK;
+    if (telemetry.has_value()) {
+        telemetry->setExpectedTotal(static_cast<long>(records.size()));
+    }
 
-        // shift the logical address 8 bits to right i.e. (8-15 -> 0-7)
-        // mask the result to ensure only lower 8 bits are kept
-        uint8_t pageNumber = (logicalAddress >> BITSHIFT) & OFFSET_MASK; // (8-15) bits of logical address
-        uint8_t offset = logicalAddress & OFFSET_MASK;                   // (0-7) bits of logical address
+    std::vector<TranslationResult> results(records.size());
+    if (!engine.replay(records, results, threadCount)) {
+        std::cerr << "Error: Physical memory is full." << std::endl;
+        return EXIT_FAILURE;
+    }
 
-        // check in TLB
-        std::optional<uint8_t> frameNumberOpt = tlb.getFrameNumber(pageNumber);
+    if (verifyMode) {
+        // results are slice-ordered in memory, and the digest excludes
+        // frame placement, so any worker count reproduces the serial
+        // pipeline's digest exactly
+        ReplayChecksum checksum;
+        checksum.addBatch(results.data(), results.size());
+        std::cout << "Replay Digest = 0x" << std::hex << std::setw(16) << std::setfill('0')
+                  << checksum.getDigest() << std::dec << std::setfill(' ') << std::endl;
+        double pageFaultRate = 100.0 * engine.getPageFaults() / engine.getTotalAddresses();
+        double tlbHitRate = 100.0 * engine.getTlbHits() / engine.getTotalAddresses();
+        std::cout << "Page Fault Rate = " << pageFaultRate << "%" << std::endl;
+        std::cout << "TLB Hit Rate = " << tlbHitRate << "%" << std::endl;
+        return EXIT_SUCCESS;
+    }
 
-        // TLB miss -> proceed to page table
-        if (bool _ = frameNumberOpt.has_value()) {
-            tlbHits++;
-        } else {
-            frameNumberOpt = pageTable.getFrameNumber(pageNumber);
+    // results are slice-ordered, so emitting them in one go preserves
+    // the input order of the trace
+    outputWriter->writeResults(results.data(), results.size());
+    outputWriter->writeStats(engine.getTotalAddresses(),
+                             engine.getTlbHits(), engine.getPageFaults());
 
-            // page fault -> load page from backing store
-            if (!frameNumberOpt.has_value()) {
-                pageFaults++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Multi-process mode: a page-server process owns the shared physical
+ * memory and frame allocator; each client process simulates one
+ * address space with a private TLB and page table, faulting through
+ * its lock-free shared-memory mailbox and dropping mappings the
+ * server evicts via its invalidation mailbox. Client i replays
+ * traceFiles[i] (the last trace is reused when there are more clients
+ * than traces).
+ * @param frameBudget server-side frame budget, 0 -> all FRAMES
+ * @return process exit code
+ */
+int runMultiProcess(const std::vector<std::string> &traceFiles, unsigned processCount,
+                    unsigned frameBudget, const std::string &evictionPolicy) {
+    if (processCount > MAX_CLIENT_PROCESSES) {
+        std::cerr << "Error: --processes supports at most " << MAX_CLIENT_PROCESSES << std::endl;
+        return EXIT_FAILURE;
+    }
 
-                // read page from backing store
-                int8_t pageData[PAGE_SIZE];
-                backingStore.readPage(pageNumber, pageData);
+    // one anonymous shared mapping carries the whole cross-process state
+    void *mapping = mmap(nullptr, sizeof(SharedRegion), PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error mapping shared region" << std::endl;
+        return EXIT_FAILURE;
+    }
+    SharedRegion *region = new (mapping) SharedRegion();
+
+    std::vector<pid_t> clients;
+    for (unsigned client = 0; client < processCount; client++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Error forking client process" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (pid != 0) {
+            clients.push_back(pid);
+            continue;
+        }
 
-                // load page into physical memory
-                physicalMemory.loadPage(nextAvailableFrame, pageData);
+        // ---- client: one simulated address space ----
+        const std::string &traceFile =
+                traceFiles[client < traceFiles.size() ? client : traceFiles.size() - 1];
 
-                // update page table
-                pageTable.setFrameNumber(pageNumber, nextAvailableFrame);
+        std::vector<uint32_t> addresses;
+        if (isBinaryTrace(traceFile)) {
+            BinaryTraceFile trace(traceFile);
+            addresses.assign(trace.records().begin(), trace.records().end());
+        } else {
+            std::ifstream addressFile(traceFile);
+            if (!addressFile) {
+                std::cerr << "Error opening address file: " << traceFile << std::endl;
+                _exit(EXIT_FAILURE);
+            }
+            std::string line;
+            while (std::getline(addressFile, line)) {
+                addresses.push_back(std::stoul(line));
+            }
+        }
 
-                // update TLB
-                tlb.addEntry(pageNumber, nextAvailableFrame);
+        PageServerClient serverClient(*region, client);
+        TLB tlb;
+        PageTable pageTable;
+        long tlbHits = 0;
+        long pageFaults = 0;
+
+        for (uint32_t address : addresses) {
+            // drop any mapping the server evicted since the last address
+            int32_t evictedPage = serverClient.pollInvalidation();
+            if (evictedPage >= 0) {
+                pageTable.invalidate(static_cast<uint8_t>(evictedPage));
+                tlb.invalidate(static_cast<uint8_t>(evictedPage));
+            }
 
-                frameNumberOpt = nextAvailableFrame;
+            uint32_t logicalAddress = address & MASK;
+            uint8_t pageNumber = (logicalAddress >> BITSHIFT) & OFFSET_MASK;
+            uint8_t offset = logicalAddress & OFFSET_MASK;
 
-                nextAvailableFrame++;
-                if (nextAvailableFrame >= FRAME_SIZE) {
-                    std::cerr << "Error: Physical memory is full." << std::endl;
-                    return EXIT_FAILURE;
-                }
+            std::optional<uint8_t> frameNumberOpt = tlb.getFrameNumber(pageNumber);
+            if (frameNumberOpt.has_value()) {
+                tlbHits++;
             } else {
-                // update TLB with page table result
+                frameNumberOpt = pageTable.getFrameNumber(pageNumber);
+                if (!frameNumberOpt.has_value()) {
+                    pageFaults++;
+                    int32_t frameNumber = serverClient.requestPage(pageNumber);
+
+                    // evictions acknowledged while spinning on the
+                    // fault are applied before the new mapping is used
+                    for (uint8_t deferred : serverClient.takeDeferredInvalidations()) {
+                        pageTable.invalidate(deferred);
+                        tlb.invalidate(deferred);
+                    }
+
+                    pageTable.setFrameNumber(pageNumber, static_cast<uint8_t>(frameNumber));
+                    frameNumberOpt = static_cast<uint8_t>(frameNumber);
+                }
                 tlb.addEntry(pageNumber, frameNumberOpt.value());
             }
+
+            uint16_t physicalAddress =
+                    static_cast<uint16_t>((frameNumberOpt.value() << 8) | offset);
+            // touch the shared frame like the single-process replay does
+            volatile int8_t value = serverClient.getValue(physicalAddress);
+            (void)value;
         }
 
-        // translate to physical address and capture value
-        uint8_t frameNumber = frameNumberOpt.value();
-        uint16_t physicalAddress = (frameNumber << 8) | offset;
-        int8_t value = physicalMemory.getValue(physicalAddress);
+        // one line per client, built first so the write is atomic-ish
+        std::ostringstream summary;
+        summary << "client " << client << " (" << traceFile << "): addresses="
+                << addresses.size() << " tlbHits=" << tlbHits
+                << " pageFaults=" << pageFaults << '\n';
+        std::cout << summary.str() << std::flush;
 
-        // terminal logs
-        std::cout << "0x" << std::hex << std::setw(4) << std::setfill('0') << logicalAddress
-                  << " -> 0x" << std::hex << std::setw(4) << std::setfill('0') << physicalAddress
-                  << " -> " << std::dec << static_cast<int>(value) << std::endl;
+        serverClient.finish();
+        _exit(EXIT_SUCCESS);
+    }
 
-        // write logs to file
-        outputFile << "0x" << std::hex << std::setw(4) << std::setfill('0') << logicalAddress
-                  << " -> 0x" << std::hex << std::setw(4) << std::setfill('0') << physicalAddress
-                  << " -> " << std::dec << static_cast<int>(value) << std::endl;
+    // ---- parent: the page server owns the store and the frames ----
+    BackingStore backingStore("BACKING_STORE.bin");
+    uint16_t serverFrames = frameBudget > 0 ? static_cast<uint16_t>(frameBudget) : FRAMES;
+    PageServer server(*region, backingStore, processCount, serverFrames, evictionPolicy);
+    server.run(clients);
+
+    int exitCode = server.hadClientFailure() ? EXIT_FAILURE : EXIT_SUCCESS;
+    for (pid_t pid : clients) {
+        int status = 0;
+        // the server may already have reaped a crashed client
+        if (waitpid(pid, &status, 0) == pid &&
+            (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)) {
+            exitCode = EXIT_FAILURE;
+        }
     }
 
-    // compute stats for display
-    double pageFaultRate = static_cast<double>(pageFaults) / totalAddresses * 100.0;
-    double tlbHitRate = static_cast<double>(tlbHits) / totalAddresses * 100.0;
+    std::cout << "page server: faults served = " << server.getFaultsServed()
+              << ", evictions = " << server.getEvictions() << " (budget " << serverFrames
+              << " frames)" << std::endl;
+
+    munmap(mapping, sizeof(SharedRegion));
+    return exitCode;
+}
 
-    // terminal logs
-    std::cout << "Page Fault Rate = " << pageFaultRate << "%" << std::endl;
-    std::cout << "TLB Hit Rate = " << tlbHitRate << "%" << std::endl;
+/**
+ * Policy-comparison mode: replays one trace through every TLB
+ * replacement strategy in a single pass - the trace is loaded and
+ * decoded once, each policy keeps its own TLB state - and reports
+ * hit rates and estimated cycle costs side by side
+ */
+int runTlbComparison(const std::string &addressFileName) {
+    // ingest the whole trace once (shared decode)
+    std::optional<BinaryTraceFile> binaryTrace;
+    std::vector<uint32_t> addresses;
+    std::span<const uint32_t> records;
+
+    if (isBinaryTrace(addressFileName)) {
+        binaryTrace.emplace(addressFileName);
+        records = binaryTrace->records();
+    } else {
+        std::ifstream addressFile(addressFileName);
+        if (!addressFile) {
+            std::cerr << "Error opening address file: " << addressFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::string line;
+        while (std::getline(addressFile, line)) {
+            addresses.push_back(std::stoul(line));
+        }
+        records = addresses;
+    }
 
-    outputFile << "Page Fault Rate = " << pageFaultRate << "%" << std::endl;
-    outputFile << "TLB Hit Rate = " << tlbHitRate << "%" << std::endl;
+    const char *policyNames[] = {"lru", "slru", "2q", "random"};
+    std::vector<PolicyTLB> tlbs;
+    for (const char *name : policyNames) {
+        tlbs.emplace_back(name);
+    }
 
-    outputFile.close();
+    // one pass, shared decode, per-policy TLB state; the frame value
+    // is irrelevant to hit behavior, so faults need no servicing here
+    for (uint32_t record : records) {
+        uint8_t pageNumber = ((record & MASK) >> BITSHIFT) & OFFSET_MASK;
+        for (PolicyTLB &tlb : tlbs) {
+            if (!tlb.getFrameNumber(pageNumber).has_value()) {
+                tlb.addEntry(pageNumber, 0);
+            }
+        }
+    }
 
+    std::cout << "TLB replacement policy comparison (" << records.size() << " references, "
+              << TLB_SIZE << " entries)" << std::endl;
+    std::cout << std::left << std::setw(10) << "policy" << std::right << std::setw(12) << "hits"
+              << std::setw(12) << "hit rate" << std::setw(18) << "est. cycles" << std::endl;
+    for (const PolicyTLB &tlb : tlbs) {
+        double hitRate = tlb.getLookups() > 0
+                ? 100.0 * static_cast<double>(tlb.getHits()) / tlb.getLookups()
+                : 0.0;
+        std::cout << std::left << std::setw(10) << tlb.getPolicyName() << std::right
+                  << std::setw(12) << tlb.getHits() << std::setw(11) << std::fixed
+                  << std::setprecision(2) << hitRate << "%" << std::setw(18)
+                  << tlb.getEstimatedCycles() << std::endl;
+    }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+int main(int argc, char *argv[]) {
+    // validate cmd line args
+    if (argc < 2) {
+        std::cerr << "Usage: ./a.out addresses.txt|addresses.trace [--tlb=deque|indexed|hierarchy|huge|lru|slru|2q|random] [--threads=N] [--processes=N] [--quiet] [--frames=N] [--policy=clock|lru|fifo] [--readahead=K] [--no-mmap] [--page-table=flat|radix|inverted|packed] [--save-state=F] [--load-state=F] [--stream] [--page-stats] [--verify] [--async-faults] [--victim-cache[=bytes]] [--telemetry[=sec]] [--telemetry-port=P] [--dedup]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // every non-option argument is a trace file; a batch of traces
+    // replays through the same warm engine
+    std::vector<std::string> traceFiles;
+
+    // pick the TLB implementation (deque scan by default, O(1) indexed
+    // variant for large TLB configurations) and the replay mode
+    // (serial batched pipeline by default, N workers with --threads)
+    std::string tlbMode = "deque";
+    unsigned threadCount = 0; // 0 -> serial batched pipeline
+    bool quiet = false;       // --quiet drops the console stream
+    unsigned frameBudget = 0; // 0 -> unlimited (all FRAMES, no eviction)
+    unsigned readaheadPages = 0; // 0 -> no readahead
+    bool useMmap = true;      // --no-mmap forces the streamed store
+    std::string pageTableMode = "flat"; // flat (dense) or radix (multi-level)
+    std::string saveStateFile;          // --save-state: checkpoint after the replay
+    std::string loadStateFile;          // --load-state: start from a warm checkpoint
+    bool streamTraces = false;          // --stream: overlapped reads instead of mmap
+    bool pageStatsReport = false;       // --page-stats: per-page heat-map report
+    bool compareTlb = false;            // --compare-tlb: one-pass policy shoot-out
+    bool verifyMode = false;            // --verify: digest line instead of full output
+    bool asyncFaults = false;           // --async-faults: overlapped fault reads
+    size_t victimCacheBytes = 0;        // --victim-cache: compressed victim pool
+    double telemetrySeconds = 0.0;      // --telemetry: live progress cadence
+    uint16_t telemetryPort = 0;         // --telemetry-port: local scrape endpoint
+    bool dedupPages = false;            // --dedup: content-based frame sharing
+    unsigned processCount = 0;          // --processes: multi-process page-server mode
+    std::string evictionPolicy = "clock";
+    for (int arg = 1; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option.rfind("--", 0) != 0) {
+            traceFiles.push_back(option);
+        } else if (option.rfind("--tlb=", 0) == 0) {
+            tlbMode = option.substr(6);
+        } else if (option.rfind("--threads=", 0) == 0) {
+            threadCount = std::stoul(option.substr(10));
+        } else if (option == "--quiet") {
+            quiet = true;
+        } else if (option.rfind("--frames=", 0) == 0) {
+            frameBudget = std::stoul(option.substr(9));
+        } else if (option.rfind("--policy=", 0) == 0) {
+            evictionPolicy = option.substr(9);
+        } else if (option.rfind("--readahead=", 0) == 0) {
+            readaheadPages = std::stoul(option.substr(12));
+        } else if (option == "--no-mmap") {
+            useMmap = false;
+        } else if (option.rfind("--page-table=", 0) == 0) {
+            pageTableMode = option.substr(13);
+        } else if (option.rfind("--save-state=", 0) == 0) {
+            saveStateFile = option.substr(13);
+        } else if (option.rfind("--load-state=", 0) == 0) {
+            loadStateFile = option.substr(13);
+        } else if (option == "--stream") {
+            streamTraces = true;
+        } else if (option == "--page-stats") {
+            pageStatsReport = true;
+        } else if (option == "--verify") {
+            verifyMode = true;
+        } else if (option == "--async-faults") {
+            asyncFaults = true;
+        } else if (option == "--telemetry") {
+            telemetrySeconds = 5.0;
+        } else if (option.rfind("--telemetry=", 0) == 0) {
+            telemetrySeconds = std::stod(option.substr(12));
+        } else if (option.rfind("--telemetry-port=", 0) == 0) {
+            telemetryPort = static_cast<uint16_t>(std::stoul(option.substr(17)));
+        } else if (option == "--dedup") {
+            dedupPages = true;
+        } else if (option == "--victim-cache") {
+            victimCacheBytes = VICTIM_CACHE_DEFAULT_BYTES;
+        } else if (option.rfind("--victim-cache=", 0) == 0) {
+            victimCacheBytes = std::stoul(option.substr(15));
+        } else if (option == "--compare-tlb") {
+            compareTlb = true;
+        } else if (option.rfind("--processes=", 0) == 0) {
+            processCount = std::stoul(option.substr(12));
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (frameBudget > FRAMES) {
+        std::cerr << "Error: --frames must be between 1 and " << FRAMES << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (frameBudget > 0 && threadCount > 0) {
+        std::cerr << "Error: --frames is not supported with --threads" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (traceFiles.empty()) {
+        std::cerr << "Error: no trace file given" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (dedupPages && (frameBudget > 0 || threadCount > 0)) {
+        std::cerr << "Error: --dedup is not supported with --frames or --threads" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ((!saveStateFile.empty() || !loadStateFile.empty()) &&
+        (frameBudget > 0 || threadCount > 0 || dedupPages)) {
+        // the v1 image carries neither eviction-policy nor dedup
+        // sharing state (refcounts, content map), and restoring
+        // without the refcounts would silently skip copy-on-write
+        std::cerr << "Error: checkpointing is not supported with --frames, --threads, or --dedup"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (traceFiles.size() > 1 && threadCount > 0) {
+        std::cerr << "Error: multiple traces are not supported with --threads" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (compareTlb) {
+        return runTlbComparison(traceFiles[0]);
+    }
+    if (processCount > 0) {
+        if (threadCount > 0) {
+            std::cerr << "Error: --processes is not supported with --threads" << std::endl;
+            return EXIT_FAILURE;
+        }
+        // --frames sets the server's shared budget; clients contend
+        // for it through the page server's eviction path
+        return runMultiProcess(traceFiles, processCount, frameBudget, evictionPolicy);
+    }
+    if (pageTableMode != "flat" && pageTableMode != "radix" && pageTableMode != "inverted" &&
+        pageTableMode != "packed") {
+        std::cerr << "Unknown page table mode: " << pageTableMode << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (pageTableMode != "flat" && threadCount > 0) {
+        std::cerr << "Error: --page-table=" << pageTableMode
+                  << " is not supported with --threads" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // one dispatch helper covers every TLB x page-table combination
+    auto replayWith = [&](auto tlbTag) -> int {
+        using ReplayTlbType = decltype(tlbTag);
+        if (threadCount > 0)
+            return runParallelReplay<ReplayTlbType>(traceFiles[0], threadCount, quiet, verifyMode, telemetrySeconds, telemetryPort);
+        if (pageTableMode == "radix")
+            return runReplay<ReplayTlbType, RadixPageTable16>(traceFiles, quiet, frameBudget, evictionPolicy, readaheadPages, useMmap, saveStateFile, loadStateFile, streamTraces, pageStatsReport, verifyMode, asyncFaults, victimCacheBytes, telemetrySeconds, telemetryPort, dedupPages);
+        if (pageTableMode == "inverted")
+            return runReplay<ReplayTlbType, InvertedPageTable>(traceFiles, quiet, frameBudget, evictionPolicy, readaheadPages, useMmap, saveStateFile, loadStateFile, streamTraces, pageStatsReport, verifyMode, asyncFaults, victimCacheBytes, telemetrySeconds, telemetryPort, dedupPages);
+        if (pageTableMode == "packed")
+            return runReplay<ReplayTlbType, PackedPageTable>(traceFiles, quiet, frameBudget, evictionPolicy, readaheadPages, useMmap, saveStateFile, loadStateFile, streamTraces, pageStatsReport, verifyMode, asyncFaults, victimCacheBytes, telemetrySeconds, telemetryPort, dedupPages);
+        return runReplay<ReplayTlbType>(traceFiles, quiet, frameBudget, evictionPolicy, readaheadPages, useMmap, saveStateFile, loadStateFile, streamTraces, pageStatsReport, verifyMode, asyncFaults, victimCacheBytes, telemetrySeconds, telemetryPort, dedupPages);
+    };
+
+    if (tlbMode == "deque")
+        return replayWith(TLB{});
+    if (tlbMode == "indexed")
+        return replayWith(IndexedTLB{});
+    if (tlbMode == "huge")
+        return replayWith(HugePageTLB{});
+    if (tlbMode == "hierarchy")
+        return replayWith(TlbHierarchy{});
+    if (tlbMode == "lru")
+        return replayWith(LruPolicyTLB{});
+    if (tlbMode == "slru")
+        return replayWith(SlruPolicyTLB{});
+    if (tlbMode == "2q")
+        return replayWith(TwoQPolicyTLB{});
+    if (tlbMode == "random")
+        return replayWith(RandomPolicyTLB{});
+
+    std::cerr << "Unknown TLB mode: " << tlbMode << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "instrumentation.h"
+#include "translation_engine.h"
+
+// application-side output buffer; a buffer is handed to the writer
+// thread only when full (or at shutdown), so a 500M-address replay
+// does a few thousand large writes instead of per-address flushes
+#define OUTPUT_BUFFER_CAPACITY (1 << 20)
+
+/** @class OutputWriter
+ *  @brief Buffered, double-buffered asynchronous result writer
+ *
+ * Replaces the per-address iostream writes of the original loop:
+ *  - results are formatted with a fixed-width hex formatter (no
+ *    std::hex/std::setw manipulator churn) into a large buffer
+ *  - lines end in '\n'; nothing is flushed per address
+ *  - a full buffer is handed to a background writer thread and
+ *    formatting continues into the second buffer, so file I/O
+ *    overlaps with translation
+ *  - --quiet suppresses the duplicate console stream entirely
+ */
+class OutputWriter {
+  private:
+    std::ofstream outputFile;
+    bool quiet;
+
+    // double buffer: translation formats into buffers[activeBuffer]
+    // while the writer thread drains the other one
+    std::vector<char> buffers[2];
+    int activeBuffer = 0;
+
+    std::thread writerThread;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDrained;
+    std::vector<char> *pendingBuffer = nullptr;
+    bool shuttingDown = false;
+
+    // hex digits for the fixed-width formatter
+    static constexpr char hexDigits[] = "0123456789abcdef";
+
+    /**
+     * Formats "0x" + 4 lowercase hex digits, matching the old
+     * std::hex << std::setw(4) << std::setfill('0') output
+     */
+    static char *formatHex16(char *out, uint16_t value) {
+        *out++ = '0';
+        *out++ = 'x';
+        *out++ = hexDigits[(value >> 12) & 0xF];
+        *out++ = hexDigits[(value >> 8) & 0xF];
+        *out++ = hexDigits[(value >> 4) & 0xF];
+        *out++ = hexDigits[value & 0xF];
+        return out;
+    }
+
+    /**
+     * Formats a signed byte value as decimal (-128..127)
+     */
+    static char *formatValue(char *out, int value) {
+        if (value < 0) {
+            *out++ = '-';
+            value = -value;
+        }
+        if (value >= 100) {
+            *out++ = static_cast<char>('0' + value / 100);
+            value %= 100;
+            *out++ = static_cast<char>('0' + value / 10);
+            *out++ = static_cast<char>('0' + value % 10);
+        } else if (value >= 10) {
+            *out++ = static_cast<char>('0' + value / 10);
+            *out++ = static_cast<char>('0' + value % 10);
+        } else {
+            *out++ = static_cast<char>('0' + value);
+        }
+        return out;
+    }
+
+    /**
+     * Writer thread body: drain handed-over buffers until shutdown
+     */
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            workReady.wait(lock, [&] { return pendingBuffer != nullptr || shuttingDown; });
+            if (pendingBuffer == nullptr)
+                return; // shutdown with nothing left to drain
+
+            std::vector<char> *buffer = pendingBuffer;
+
+            // drop the lock for the actual I/O so formatting continues
+            lock.unlock();
+            outputFile.write(buffer->data(), buffer->size());
+            if (!quiet) {
+                std::cout.write(buffer->data(), buffer->size());
+            }
+            buffer->clear();
+            lock.lock();
+
+            pendingBuffer = nullptr;
+            workDrained.notify_one();
+        }
+    }
+
+    /**
+     * Hands the active buffer to the writer thread and switches to
+     * the drained one
+     */
+    void rotateBuffers() {
+        std::unique_lock<std::mutex> lock(mutex);
+        workDrained.wait(lock, [&] { return pendingBuffer == nullptr; });
+        pendingBuffer = &buffers[activeBuffer];
+        workReady.notify_one();
+        activeBuffer ^= 1;
+    }
+
+    /**
+     * Appends raw bytes, rotating buffers when the active one is full
+     */
+    void append(const char *data, size_t length) {
+        if (buffers[activeBuffer].size() + length > OUTPUT_BUFFER_CAPACITY) {
+            rotateBuffers();
+        }
+        buffers[activeBuffer].insert(buffers[activeBuffer].end(), data, data + length);
+    }
+
+  public:
+    /**
+     * Constructor: open the output file and start the writer thread
+     * @param fileName path of the result log (correct.txt)
+     * @param quiet suppress the duplicate console stream
+     *
+     * Terminate if file cannot be opened
+     */
+    explicit OutputWriter(const std::string &fileName, bool quiet = false)
+        : quiet(quiet) {
+        outputFile.open(fileName);
+        if (!outputFile) {
+            std::cerr << "Error opening " << fileName << " file: " << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        buffers[0].reserve(OUTPUT_BUFFER_CAPACITY);
+        buffers[1].reserve(OUTPUT_BUFFER_CAPACITY);
+        writerThread = std::thread(&OutputWriter::writerLoop, this);
+    }
+
+    /**
+     * Destructor: drain whatever is buffered and stop the writer
+     */
+    ~OutputWriter() {
+        if (!buffers[activeBuffer].empty()) {
+            rotateBuffers();
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workDrained.wait(lock, [&] { return pendingBuffer == nullptr; });
+            shuttingDown = true;
+            workReady.notify_one();
+        }
+        writerThread.join();
+        outputFile.close();
+    }
+
+    /**
+     * Formats and buffers one batch of translation results
+     * @param results translated batch
+     * @param count number of entries to emit
+     */
+    void writeResults(const TranslationResult *results, size_t count) {
+        ScopedStageTimer timer(Stage::OutputEmit);
+
+        // worst case line: 0xNNNN -> 0xNNNN -> -NNN\n = 25 chars
+        char line[32];
+        for (size_t i = 0; i < count; i++) {
+            char *out = formatHex16(line, results[i].logicalAddress);
+            *out++ = ' ';
+            *out++ = '-';
+            *out++ = '>';
+            *out++ = ' ';
+            out = formatHex16(out, results[i].physicalAddress);
+            *out++ = ' ';
+            *out++ = '-';
+            *out++ = '>';
+            *out++ = ' ';
+            out = formatValue(out, results[i].value);
+            *out++ = '\n';
+            append(line, out - line);
+        }
+    }
+
+    /**
+     * Buffers one preformatted line block (extra stats reports)
+     */
+    void writeText(const std::string &text) {
+        append(text.data(), text.size());
+    }
+
+    /**
+     * Formats and buffers the end-of-replay statistics
+     */
+    void writeStats(long totalAddresses, long tlbHits, long pageFaults) {
+        double pageFaultRate = static_cast<double>(pageFaults) / totalAddresses * 100.0;
+        double tlbHitRate = static_cast<double>(tlbHits) / totalAddresses * 100.0;
+
+        // cold path: ostringstream keeps the exact default double
+        // formatting the stats lines have always used
+        std::ostringstream stats;
+        stats << "Page Fault Rate = " << pageFaultRate << "%" << '\n';
+        stats << "TLB Hit Rate = " << tlbHitRate << "%" << '\n';
+        std::string text = stats.str();
+        append(text.data(), text.size());
+    }
+};
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "vmm_config.h"
+#include "backing_store.h"
+#include "frame_allocator.h"
+
+// upper bound on simultaneously simulated address spaces
+#define MAX_CLIENT_PROCESSES 16
+
+/**
+ * Multi-process mode: a page-server process owns physical memory and
+ * the frame allocator in a POSIX shared-memory segment; client replay
+ * processes (one per simulated address space) translate through their
+ * own page tables and request faults through per-client lock-free
+ * shared-memory mailboxes - no pipes, no syscalls on the fault path
+ * beyond the page read itself.
+ *
+ * A client fault is synchronous (the translation loop cannot proceed
+ * until the page is resident), so the request channel is a
+ * one-deep ring: a single cache-line mailbox per client, advanced
+ * with acquire/release transitions EMPTY -> REQUEST -> REPLY -> EMPTY.
+ *
+ * Frames come from the server-side FrameAllocator, so combined
+ * working sets larger than the budget evict instead of failing. An
+ * eviction displaces some client's page; that client is told through
+ * its invalidation mailbox (same lock-free pattern) and must
+ * acknowledge before the frame is reused, so a stale mapping can
+ * never read recycled frame data. Clients poll the invalidation
+ * mailbox once per translated address and while spinning on their own
+ * faults - which is also what makes the ack wait deadlock-free: a
+ * client blocked on its own fault still acknowledges evictions.
+ * Cross-process contention now shows up as eviction interference
+ * (faults and invalidations), not as mid-replay failures.
+ */
+
+/** @struct FaultMailbox
+ *  @brief One client's fault channel, padded to its own cache line
+ */
+struct alignas(64) FaultMailbox {
+    enum State : uint32_t { EMPTY = 0, REQUEST, REPLY, DONE };
+
+    std::atomic<uint32_t> state{EMPTY};
+    uint32_t pageNumber = 0;
+    int32_t resultFrame = 0;
+};
+
+/** @struct InvalidateMailbox
+ *  @brief Server -> client eviction notice, one outstanding at a time
+ */
+struct alignas(64) InvalidateMailbox {
+    enum State : uint32_t { IDLE = 0, PENDING };
+
+    std::atomic<uint32_t> state{IDLE};
+    uint32_t pageNumber = 0;
+};
+
+/** @struct SharedRegion
+ *  @brief The whole cross-process state, one anonymous shared mapping
+ */
+struct SharedRegion {
+    FaultMailbox mailboxes[MAX_CLIENT_PROCESSES];
+    InvalidateMailbox invalidations[MAX_CLIENT_PROCESSES];
+
+    // the shared physical memory all address spaces compete for
+    int8_t frames[FRAMES][FRAME_SIZE];
+};
+
+/** @class PageServer
+ *  @brief Server loop: services fault mailboxes until every client is done
+ */
+class PageServer {
+  private:
+    SharedRegion &region;
+    BackingStore &backingStore;
+    unsigned clientCount;
+    bool clientFailed = false;
+
+    // frame management lives server-side: the allocator picks victims
+    // and the owner maps track which client's page sits in each frame
+    FrameAllocator allocator;
+    std::vector<int16_t> frameOwner; // -1 -> frame never used yet
+
+    // clients reaped early (dead owner found during an ack wait);
+    // run() must not waitpid them a second time
+    std::vector<bool> reapedClients;
+
+    // statistics
+    long faultsServed = 0;
+    long evictions = 0;
+
+    /**
+     * Tells a client one of its pages was evicted and waits for the
+     * acknowledgement before the frame is reused. A client that has
+     * finished (or died) cannot use the stale mapping anymore, so its
+     * ack is implicit.
+     * @param owner client whose page was displaced
+     * @param pageNumber displaced page
+     * @param clientPids pids, for detecting dead owners
+     */
+    void invalidateAndWait(unsigned owner, uint8_t pageNumber,
+                           const std::vector<pid_t> &clientPids) {
+        InvalidateMailbox &notice = region.invalidations[owner];
+        notice.pageNumber = pageNumber;
+        notice.state.store(InvalidateMailbox::PENDING, std::memory_order_release);
+
+        while (notice.state.load(std::memory_order_acquire) != InvalidateMailbox::IDLE) {
+            if (region.mailboxes[owner].state.load(std::memory_order_acquire) ==
+                FaultMailbox::DONE) {
+                break; // finished client: implicit ack
+            }
+            if (reapedClients[owner]) {
+                break; // already found dead earlier: implicit ack
+            }
+            if (waitpid(clientPids[owner], nullptr, WNOHANG) == clientPids[owner]) {
+                // dead client: implicit ack; remember the reap so the
+                // main loop does not wait for this pid a second time
+                reapedClients[owner] = true;
+                clientFailed = true;
+                break;
+            }
+        }
+    }
+
+  public:
+    /**
+     * Constructor: build the server-side frame allocator
+     * @param frameBudget frames available to all clients together
+     * @param evictionPolicy victim policy; the server only observes
+     *        faults (client accesses never cross the process
+     *        boundary), so recency policies see fault order only
+     */
+    PageServer(SharedRegion &region, BackingStore &backingStore, unsigned clientCount,
+               uint16_t frameBudget, const std::string &evictionPolicy)
+        : region(region), backingStore(backingStore), clientCount(clientCount),
+          allocator(frameBudget, evictionPolicy), frameOwner(frameBudget, -1),
+          reapedClients(clientCount, false) {}
+
+    /**
+     * Polls the mailboxes, loading pages into shared frames, until
+     * every client has signalled DONE (a client that dies without
+     * signalling - e.g. crashes mid-trace - is reaped and treated as
+     * done, so the server can never hang on a dead peer)
+     * @param clientPids one pid per client, indexed like the mailboxes
+     */
+    void run(const std::vector<pid_t> &clientPids) {
+        unsigned doneClients = 0;
+        std::vector<bool> finished(clientCount, false);
+
+        while (doneClients < clientCount) {
+            for (unsigned client = 0; client < clientCount; client++) {
+                if (finished[client])
+                    continue;
+
+                FaultMailbox &mailbox = region.mailboxes[client];
+                uint32_t state = mailbox.state.load(std::memory_order_acquire);
+
+                if (state == FaultMailbox::DONE) {
+                    finished[client] = true;
+                    doneClients++;
+                    continue;
+                }
+                if (state == FaultMailbox::EMPTY) {
+                    int status = 0;
+                    if (reapedClients[client]) {
+                        // found dead during an ack wait; already reaped
+                        finished[client] = true;
+                        doneClients++;
+                        continue;
+                    }
+                    if (waitpid(clientPids[client], &status, WNOHANG) == clientPids[client]) {
+                        // client exited without a request pending
+                        reapedClients[client] = true;
+                        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+                            clientFailed = true;
+                        }
+                        finished[client] = true;
+                        doneClients++;
+                        continue;
+                    }
+                }
+                if (state != FaultMailbox::REQUEST)
+                    continue;
+
+                // allocate a frame, evicting (and invalidating the
+                // displaced owner's mapping) when the budget is full
+                uint8_t pageNumber = static_cast<uint8_t>(mailbox.pageNumber);
+                FrameAllocator::Allocation allocation = allocator.allocate(pageNumber);
+                if (allocation.evictedPage != -1) {
+                    evictions++;
+                    invalidateAndWait(static_cast<unsigned>(frameOwner[allocation.frameNumber]),
+                                      static_cast<uint8_t>(allocation.evictedPage), clientPids);
+                }
+                frameOwner[allocation.frameNumber] = static_cast<int16_t>(client);
+
+                backingStore.readPage(pageNumber, region.frames[allocation.frameNumber]);
+                faultsServed++;
+
+                mailbox.resultFrame = static_cast<int32_t>(allocation.frameNumber);
+                mailbox.state.store(FaultMailbox::REPLY, std::memory_order_release);
+            }
+        }
+    }
+
+    /** @return true when any client was reaped with a failure */
+    bool hadClientFailure() const { return clientFailed; }
+
+    long getFaultsServed() const { return faultsServed; }
+    long getEvictions() const { return evictions; }
+};
+
+/** @class PageServerClient
+ *  @brief Client-side fault path: one synchronous mailbox round trip
+ */
+class PageServerClient {
+  private:
+    SharedRegion &region;
+    unsigned clientId;
+
+    // eviction notices acknowledged while spinning on a fault; the
+    // stale mappings are dropped right after the fault completes,
+    // before the next translation
+    std::vector<uint8_t> deferredInvalidations;
+
+  public:
+    PageServerClient(SharedRegion &region, unsigned clientId)
+        : region(region), clientId(clientId) {
+        deferredInvalidations.reserve(8);
+    }
+
+    /**
+     * Polls the invalidation mailbox (call once per translated address)
+     * @return the evicted page to drop from the page table and TLB,
+     *         or -1 when nothing is pending
+     */
+    int32_t pollInvalidation() {
+        InvalidateMailbox &notice = region.invalidations[clientId];
+        if (notice.state.load(std::memory_order_acquire) != InvalidateMailbox::PENDING)
+            return -1;
+        int32_t pageNumber = static_cast<int32_t>(notice.pageNumber);
+        notice.state.store(InvalidateMailbox::IDLE, std::memory_order_release);
+        return pageNumber;
+    }
+
+    /**
+     * Requests a frame for a faulting page from the server
+     * @param pageNumber faulting page
+     * @return frame number holding the page
+     */
+    int32_t requestPage(uint8_t pageNumber) {
+        FaultMailbox &mailbox = region.mailboxes[clientId];
+        mailbox.pageNumber = pageNumber;
+        mailbox.state.store(FaultMailbox::REQUEST, std::memory_order_release);
+
+        // synchronous fault: spin until the server replies, but keep
+        // acknowledging eviction notices - the server may be waiting
+        // on exactly this client before it can hand out a frame
+        while (mailbox.state.load(std::memory_order_acquire) != FaultMailbox::REPLY) {
+            int32_t evictedPage = pollInvalidation();
+            if (evictedPage >= 0) {
+                deferredInvalidations.push_back(static_cast<uint8_t>(evictedPage));
+            }
+        }
+
+        int32_t frameNumber = mailbox.resultFrame;
+        mailbox.state.store(FaultMailbox::EMPTY, std::memory_order_release);
+        return frameNumber;
+    }
+
+    /**
+     * Hands out the eviction notices collected during the last fault
+     */
+    std::vector<uint8_t> takeDeferredInvalidations() {
+        std::vector<uint8_t> taken = std::move(deferredInvalidations);
+        deferredInvalidations.clear();
+        return taken;
+    }
+
+    /**
+     * Signals that this address space has finished its trace
+     */
+    void finish() {
+        region.mailboxes[clientId].state.store(FaultMailbox::DONE, std::memory_order_release);
+    }
+
+    /**
+     * Reads one byte from the shared physical memory
+     */
+    int8_t getValue(uint16_t physicalAddress) const {
+        return region.frames[(physicalAddress >> 8) & 0xFF][physicalAddress & 0xFF];
+    }
+};
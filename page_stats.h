@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+// sample one reference in 64 for the reuse-distance histogram; the
+// flat per-page counters are cheap enough to run unsampled
+#define REUSE_SAMPLE_MASK 63
+
+/** @class PageStatsEngine
+ *  @brief Opt-in per-page reference/fault accounting with a heat map
+ *
+ * Answers the capacity-planning question the two aggregate rates
+ * cannot: *which* pages are hot. Keeps cache-friendly flat arrays of
+ * per-page reference counts, fault counts, and last-reference indices;
+ * reuse distance is approximated by the reference-index gap between
+ * consecutive touches of a page, sampled (1 in 64) so the hot path
+ * pays one store and a masked branch per reference.
+ *
+ * At the end of a replay writeReport() emits a CSV: the pages sorted
+ * hottest-first (reference count, fault count, share of traffic)
+ * followed by the log2 reuse-distance histogram.
+ */
+class PageStatsEngine {
+  private:
+    std::array<uint64_t, PAGE_TABLE_SIZE> referenceCounts{};
+    std::array<uint64_t, PAGE_TABLE_SIZE> faultCounts{};
+    std::array<int64_t, PAGE_TABLE_SIZE> lastReference;
+
+    // log2-bucketed approximate reuse distances (sampled)
+    std::array<uint64_t, 64> reuseHistogram{};
+
+    uint64_t referenceIndex = 0;
+
+  public:
+    PageStatsEngine() {
+        lastReference.fill(-1);
+    }
+
+    /**
+     * Accounts one reference to a page (every translated address)
+     */
+    void onReference(uint8_t pageNumber) {
+        referenceCounts[pageNumber]++;
+
+        if ((referenceIndex & REUSE_SAMPLE_MASK) == 0 && lastReference[pageNumber] != -1) {
+            uint64_t distance = referenceIndex - static_cast<uint64_t>(lastReference[pageNumber]);
+            int bucket = distance == 0 ? 0 : 64 - __builtin_clzll(distance);
+            if (bucket > 63)
+                bucket = 63;
+            reuseHistogram[bucket]++;
+        }
+        lastReference[pageNumber] = static_cast<int64_t>(referenceIndex);
+        referenceIndex++;
+    }
+
+    /**
+     * Accounts one page fault
+     */
+    void onFault(uint8_t pageNumber) {
+        faultCounts[pageNumber]++;
+    }
+
+    /**
+     * Rewinds all counters (next trace in a batch starts fresh)
+     */
+    void reset() {
+        referenceCounts.fill(0);
+        faultCounts.fill(0);
+        lastReference.fill(-1);
+        reuseHistogram.fill(0);
+        referenceIndex = 0;
+    }
+
+    /**
+     * Emits the sorted heat map and the reuse-distance histogram
+     * @param fileName CSV report path
+     */
+    void writeReport(const std::string &fileName) const {
+        std::ofstream report(fileName);
+        if (!report) {
+            std::cerr << "Error opening page stats report: " << fileName << std::endl;
+            return;
+        }
+
+        // heat map: hottest pages first
+        std::vector<unsigned> pages(PAGE_TABLE_SIZE);
+        for (unsigned page = 0; page < PAGE_TABLE_SIZE; page++)
+            pages[page] = page;
+        std::sort(pages.begin(), pages.end(), [&](unsigned a, unsigned b) {
+            return referenceCounts[a] > referenceCounts[b];
+        });
+
+        report << "page,references,faults,share\n";
+        for (unsigned page : pages) {
+            if (referenceCounts[page] == 0)
+                break; // sorted: everything after is cold too
+            report << page << "," << referenceCounts[page] << "," << faultCounts[page] << ","
+                   << (referenceIndex > 0
+                               ? static_cast<double>(referenceCounts[page]) / referenceIndex
+                               : 0.0)
+                   << "\n";
+        }
+
+        // approximate reuse-distance histogram (sampled 1 in 64)
+        report << "\nreuse_distance_log2_bucket,samples\n";
+        for (int bucket = 0; bucket < 64; bucket++) {
+            if (reuseHistogram[bucket] != 0) {
+                report << bucket << "," << reuseHistogram[bucket] << "\n";
+            }
+        }
+    }
+};
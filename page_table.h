@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+/** @class PageTable
+ *  @brief Manages virtual-to-physical memory mapping
+ */
+class PageTable {
+  private:
+    // stores frame numbers, with -1 -> invalid/unloaded page
+    std::array<int16_t, PAGE_TABLE_SIZE> pageTable{};
+
+  public:
+    /**
+     * Constructor: initialize all entries as invalid (-1)
+     */
+    PageTable() {
+        pageTable.fill(-1);
+    }
+
+    /**
+     * Drops every mapping (next trace in a batch starts cold)
+     */
+    void reset() {
+        pageTable.fill(-1);
+    }
+
+    /**
+     * Fetches the frame number for a given page
+     * @param pageNumber virtual page number to lookup
+     * @return optional frame number or empty in case of page fault
+     */
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        int16_t frameNumber = pageTable[pageNumber];
+        if (frameNumber != -1)
+            return static_cast<uint8_t>(frameNumber);
+        return std::nullopt;
+    }
+
+    /**
+     * Updates page table with a new page <> frame mapping
+     * @param pageNumber virtual page number
+     * @param frameNumber physical frame number
+     */
+    void setFrameNumber(uint8_t pageNumber, uint8_t frameNumber) {
+        pageTable[pageNumber] = frameNumber;
+    }
+
+    /**
+     * Drops a mapping when its page is evicted from physical memory
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint8_t pageNumber) {
+        pageTable[pageNumber] = -1;
+    }
+};
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "physical_memory.h"
+#include "backing_store.h"
+#include "translation_engine.h"
+
+// number of independent locks protecting the shared fault path; faults
+// on different stripes (pageNumber % FAULT_LOCK_STRIPES) never contend
+#define FAULT_LOCK_STRIPES 16
+
+/** @struct WorkerStats
+ *  @brief Per-thread statistics counters
+ *
+ * Padded out to a cache line so two workers bumping their counters
+ * never false-share. Relaxed atomics (the same plain add on x86) so
+ * the telemetry thread can snapshot them while the workers run.
+ */
+struct alignas(64) WorkerStats {
+    std::atomic<long> totalAddresses{0};
+    std::atomic<long> tlbHits{0};
+    std::atomic<long> pageFaults{0};
+};
+
+/** @class SharedPageTable
+ *  @brief Page table shared across replay workers
+ *
+ * Entries are atomics: lookups are lock-free loads, and a mapping is
+ * published with release ordering only after the frame data is resident,
+ * so a worker that sees the entry also sees the loaded page.
+ */
+class SharedPageTable {
+  private:
+    std::array<std::atomic<int16_t>, PAGE_TABLE_SIZE> pageTable;
+
+  public:
+    SharedPageTable() {
+        for (auto &entry : pageTable)
+            entry.store(-1, std::memory_order_relaxed);
+    }
+
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        int16_t frameNumber = pageTable[pageNumber].load(std::memory_order_acquire);
+        if (frameNumber != -1)
+            return static_cast<uint8_t>(frameNumber);
+        return std::nullopt;
+    }
+
+    void setFrameNumber(uint8_t pageNumber, uint8_t frameNumber) {
+        pageTable[pageNumber].store(frameNumber, std::memory_order_release);
+    }
+};
+
+/** @class ParallelReplayEngine
+ *  @brief Multi-threaded trace replay over a shared physical memory
+ *
+ * The input address block is partitioned into contiguous slices, one
+ * per worker. Every worker owns a private TLB (no sharing, like real
+ * per-core TLBs) and translates its slice against the shared
+ * SharedPageTable/PhysicalMemory. The fault path is serialized per
+ * page-number stripe with double-checked locking, so two workers
+ * faulting on the same page load it once, while faults on unrelated
+ * pages proceed in parallel. Counters are per-worker, cache-line
+ * padded, and merged after the join.
+ */
+template <typename TlbType>
+class ParallelReplayEngine {
+  private:
+    SharedPageTable &pageTable;
+    PhysicalMemory &physicalMemory;
+    BackingStore &backingStore;
+
+    std::array<std::mutex, FAULT_LOCK_STRIPES> faultLocks;
+    std::atomic<uint16_t> nextAvailableFrame{0};
+    std::atomic<bool> outOfFrames{false};
+
+    // per-worker counters, preallocated so the telemetry thread can
+    // sum them while the replay runs (slices beyond the clamped
+    // worker count simply stay zero)
+    std::vector<WorkerStats> workerStats;
+
+    /**
+     * Resolves one page fault under the page's stripe lock
+     * @param pageNumber faulting page
+     * @return frame number, or empty if physical memory is exhausted
+     */
+    std::optional<uint8_t> serviceFault(uint8_t pageNumber) {
+        std::lock_guard<std::mutex> guard(faultLocks[pageNumber % FAULT_LOCK_STRIPES]);
+
+        // double-check: another worker may have loaded the page while
+        // we waited on the stripe
+        std::optional<uint8_t> frameNumberOpt = pageTable.getFrameNumber(pageNumber);
+        if (frameNumberOpt.has_value())
+            return frameNumberOpt;
+
+        uint16_t frameNumber = nextAvailableFrame.fetch_add(1);
+        if (frameNumber >= FRAMES) {
+            outOfFrames.store(true);
+            return std::nullopt;
+        }
+
+        // make the page resident before publishing the mapping
+        if (backingStore.isMapped()) {
+            physicalMemory.aliasPage(frameNumber, backingStore.pageData(pageNumber));
+        } else {
+            int8_t pageData[PAGE_SIZE];
+            backingStore.readPage(pageNumber, pageData);
+            physicalMemory.loadPage(frameNumber, pageData);
+        }
+        pageTable.setFrameNumber(pageNumber, frameNumber);
+        return static_cast<uint8_t>(frameNumber);
+    }
+
+    /**
+     * Worker body: translate one contiguous slice with a private TLB
+     */
+    void workerLoop(const uint32_t *addresses, TranslationResult *results,
+                    size_t count, WorkerStats &stats) {
+        TlbType tlb;
+
+        for (size_t i = 0; i < count; i++) {
+            if (outOfFrames.load(std::memory_order_relaxed))
+                return;
+
+            uint32_t logicalAddress = addresses[i] & MASK;
+            uint8_t pageNumber = (logicalAddress >> BITSHIFT) & OFFSET_MASK;
+            uint8_t offset = logicalAddress & OFFSET_MASK;
+
+            stats.totalAddresses.fetch_add(1, std::memory_order_relaxed);
+
+            std::optional<uint8_t> frameNumberOpt = tlb.getFrameNumber(pageNumber);
+            if (frameNumberOpt.has_value()) {
+                stats.tlbHits.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                frameNumberOpt = pageTable.getFrameNumber(pageNumber);
+
+                if (!frameNumberOpt.has_value()) {
+                    stats.pageFaults.fetch_add(1, std::memory_order_relaxed);
+                    frameNumberOpt = serviceFault(pageNumber);
+                    if (!frameNumberOpt.has_value())
+                        return; // physical memory exhausted
+                }
+                tlb.addEntry(pageNumber, frameNumberOpt.value());
+            }
+
+            uint16_t physicalAddress =
+                    static_cast<uint16_t>((frameNumberOpt.value() << 8) | offset);
+            results[i].logicalAddress = static_cast<uint16_t>(logicalAddress);
+            results[i].physicalAddress = physicalAddress;
+            results[i].value = physicalMemory.getValue(physicalAddress);
+        }
+    }
+
+  public:
+    /**
+     * @param maxWorkers upper bound on worker threads; fixes the
+     *        counter array so mid-run snapshots never race a resize
+     */
+    ParallelReplayEngine(SharedPageTable &pageTable, PhysicalMemory &physicalMemory,
+                         BackingStore &backingStore, unsigned maxWorkers = 1)
+        : pageTable(pageTable), physicalMemory(physicalMemory), backingStore(backingStore),
+          workerStats(maxWorkers > 0 ? maxWorkers : 1) {}
+
+    /**
+     * Replays a whole address block across worker threads
+     * @param addresses decoded logical addresses for the full trace
+     * @param results output, one entry per address, in input order
+     * @param threadCount number of worker threads to spawn
+     * @return false if physical memory filled up during the replay
+     */
+    bool replay(std::span<const uint32_t> addresses,
+                std::vector<TranslationResult> &results, unsigned threadCount) {
+        size_t count = addresses.size();
+        if (threadCount == 0)
+            threadCount = 1;
+        if (threadCount > count && count > 0)
+            threadCount = count;
+        if (threadCount > workerStats.size())
+            threadCount = static_cast<unsigned>(workerStats.size());
+
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+
+        // contiguous slices, remainder spread over the first workers
+        size_t baseSlice = count / threadCount;
+        size_t remainder = count % threadCount;
+        size_t start = 0;
+        for (unsigned worker = 0; worker < threadCount; worker++) {
+            size_t sliceSize = baseSlice + (worker < remainder ? 1 : 0);
+            workers.emplace_back(&ParallelReplayEngine::workerLoop, this,
+                                 addresses.data() + start, results.data() + start,
+                                 sliceSize, std::ref(workerStats[worker]));
+            start += sliceSize;
+        }
+        for (auto &worker : workers)
+            worker.join();
+
+        return !outOfFrames.load();
+    }
+
+    // sums over the padded per-worker counters; safe to call from the
+    // telemetry thread mid-run (relaxed loads) and exact after join
+    long getTotalAddresses() const {
+        long total = 0;
+        for (const WorkerStats &stats : workerStats)
+            total += stats.totalAddresses.load(std::memory_order_relaxed);
+        return total;
+    }
+    long getTlbHits() const {
+        long total = 0;
+        for (const WorkerStats &stats : workerStats)
+            total += stats.tlbHits.load(std::memory_order_relaxed);
+        return total;
+    }
+    long getPageFaults() const {
+        long total = 0;
+        for (const WorkerStats &stats : workerStats)
+            total += stats.pageFaults.load(std::memory_order_relaxed);
+        return total;
+    }
+};
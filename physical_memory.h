@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+/** @class PhysicalMemory
+ *  @brief Simulates physical memory organization
+ */
+class PhysicalMemory {
+  private:
+    // 2D array to represent physical memory frames
+    // each frame -> fixed size array of bytes
+    std::array<std::array<int8_t, FRAME_SIZE>, FRAMES> memory{}; // Memory frames
+
+    // per-frame data pointer: either the frame's own storage, or (for
+    // read-only workloads backed by an mmap'd store) an alias straight
+    // into the mapping, skipping the load copy entirely
+    std::array<const int8_t *, FRAMES> framePointers{};
+
+  public:
+    /**
+     * Constructor: point every frame at its own storage
+     */
+    PhysicalMemory() {
+        for (size_t frame = 0; frame < FRAMES; frame++) {
+            framePointers[frame] = memory[frame].data();
+        }
+    }
+
+    /**
+     *  Loads a complete page into a specific memory frame
+     * @param frameNumber target frame to load the page into
+     * @param pageData pointer of the source pageData
+     */
+    void loadPage(uint8_t frameNumber, const int8_t *pageData) {
+        std::copy_n(pageData, FRAME_SIZE, memory[frameNumber].begin());
+        framePointers[frameNumber] = memory[frameNumber].data();
+    }
+
+    /**
+     * Aliases a frame directly onto externally owned page data (e.g. a
+     * page inside an mmap'd backing store) - zero-copy, read-only
+     * @param frameNumber target frame
+     * @param pageData externally owned page, must outlive the alias
+     */
+    void aliasPage(uint8_t frameNumber, const int8_t *pageData) {
+        framePointers[frameNumber] = pageData;
+    }
+
+    /**
+     * Stores a single byte at a specific physicalAddress
+     * @param physicalAddress fully translated memory address
+     * @param value byte to store
+     *
+     * A frame aliasing a read-only mapped page is un-aliased first
+     * (copy-on-write into the frame's own storage), so stores never
+     * touch the mapping
+     */
+    void setValue(uint16_t physicalAddress, int8_t value) {
+        uint8_t frameNumber = (physicalAddress >> 8) & 0xFF;
+        uint8_t offset = physicalAddress & 0xFF;
+        if (framePointers[frameNumber] != memory[frameNumber].data()) {
+            // un-alias: pull the mapped page into writable storage
+            std::copy_n(framePointers[frameNumber], FRAME_SIZE, memory[frameNumber].begin());
+            framePointers[frameNumber] = memory[frameNumber].data();
+        }
+        memory[frameNumber][offset] = value;
+    }
+
+    /**
+     * @return the frame's current contents (own storage or alias)
+     */
+    const int8_t *frameData(uint8_t frameNumber) const {
+        return framePointers[frameNumber];
+    }
+
+    /**
+     * Hands out a frame's own writable storage for an asynchronous
+     * fill, un-aliasing it so getValue reads the filled bytes
+     * @param frameNumber target frame
+     * @return PAGE_SIZE bytes of frame storage
+     */
+    int8_t *frameStorage(uint8_t frameNumber) {
+        framePointers[frameNumber] = memory[frameNumber].data();
+        return memory[frameNumber].data();
+    }
+
+    /**
+     * Issues a software prefetch for the cache line a coming value
+     * load will touch (the batched pipeline knows its physical
+     * addresses several iterations early)
+     */
+    void prefetchValue(uint16_t physicalAddress) const {
+        uint8_t frameNumber = (physicalAddress >> 8) & 0xFF;
+        uint8_t offset = physicalAddress & 0xFF;
+        __builtin_prefetch(framePointers[frameNumber] + offset, 0, 1);
+    }
+
+    /**
+     * Retrieves single byte from a specific physicalAddress
+     * @param physicalAddress fully translated memory address
+     * @return byte value of the specified address
+     *
+     * Translation:
+     *  high order bits -> frame number
+     *  low order bits -> offset within the frame
+     */
+    int8_t getValue(uint16_t physicalAddress) const {
+        uint8_t frameNumber = (physicalAddress >> 8) & 0xFF;
+        uint8_t offset = physicalAddress & 0xFF;
+        return framePointers[frameNumber][offset];
+    }
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <cstdint>
+
+#include "arena.h"
+#include "vmm_config.h"
+#include "page_table.h"
+
+/** @class RadixPageTable
+ *  @brief Multi-level page table for large, sparse virtual address spaces
+ *
+ * The flat PageTable spends memory proportional to the virtual address
+ * space, which is fine at 2^16 but hopeless for 48-bit traces. This
+ * radix tree spends memory proportional to the *mapped* pages instead:
+ * interior nodes are allocated lazily on the first mapping that needs
+ * them, exactly like the x86-64 4-level layout (the default template
+ * arguments - 48 virtual bits, 4 KiB pages, 9-bit indices - reproduce
+ * that geometry: 36 index bits walked in four 9-bit levels).
+ *
+ * The dense single-level PageTable remains the right choice for the
+ * simulator's 16-bit space - RadixPageTable16 below adapts a two-level
+ * instance to the same interface for comparison runs, and the flat
+ * table stays the default so the current workload loses nothing.
+ *
+ * @tparam VirtualAddressBits total virtual address width
+ * @tparam PageBits           log2 of the page size
+ * @tparam LevelBits          index bits consumed per level
+ */
+template <unsigned VirtualAddressBits = 48, unsigned PageBits = 12, unsigned LevelBits = 9>
+class RadixPageTable {
+  private:
+    static constexpr unsigned INDEX_BITS = VirtualAddressBits - PageBits;
+    static constexpr unsigned LEVEL_COUNT = (INDEX_BITS + LevelBits - 1) / LevelBits;
+    static constexpr size_t FANOUT = size_t{1} << LevelBits;
+    static constexpr uint64_t LEVEL_MASK = FANOUT - 1;
+
+    static_assert(INDEX_BITS > 0, "virtual space must be larger than one page");
+
+    // interior node: child pointers, leaf node: frame entries (-1 invalid)
+    struct InteriorNode {
+        std::array<void *, FANOUT> children{};
+    };
+    struct LeafNode {
+        std::array<int64_t, FANOUT> frames;
+        LeafNode() { frames.fill(-1); }
+    };
+
+    InteriorNode root;
+
+    // all nodes live in the arena: allocation is a pointer bump and
+    // reset() reclaims every node at once between trace replays
+    Arena arena;
+    size_t nodeCount = 0;
+
+    /** Index into a level's node for a page number (level 0 = leaf) */
+    static unsigned levelIndex(uint64_t pageNumber, unsigned level) {
+        return static_cast<unsigned>((pageNumber >> (level * LevelBits)) & LEVEL_MASK);
+    }
+
+    /**
+     * Walks down to the leaf for a page
+     * @param pageNumber virtual page number
+     * @param allocate build missing interior/leaf nodes on the way down
+     * @return the leaf node, or nullptr when the path does not exist
+     */
+    LeafNode *walk(uint64_t pageNumber, bool allocate) {
+        InteriorNode *node = &root;
+        for (unsigned level = LEVEL_COUNT - 1; level > 0; level--) {
+            void *&slot = node->children[levelIndex(pageNumber, level)];
+            if (slot == nullptr) {
+                if (!allocate)
+                    return nullptr;
+                if (level == 1) {
+                    slot = arena.create<LeafNode>();
+                } else {
+                    slot = arena.create<InteriorNode>();
+                }
+                nodeCount++;
+            }
+            if (level == 1)
+                return static_cast<LeafNode *>(slot);
+            node = static_cast<InteriorNode *>(slot);
+        }
+        // single-level configuration: the root's children are frames;
+        // not supported, LEVEL_COUNT >= 2 is enforced by the geometry
+        return nullptr;
+    }
+
+  public:
+    static_assert(LEVEL_COUNT >= 2, "use the flat PageTable for single-level geometries");
+
+    /**
+     * Fetches the frame number for a given page
+     * @param pageNumber virtual page number to lookup
+     * @return optional frame number or empty in case of page fault
+     */
+    std::optional<uint64_t> getFrameNumber(uint64_t pageNumber) {
+        LeafNode *leaf = walk(pageNumber, false);
+        if (leaf == nullptr)
+            return std::nullopt;
+        int64_t frameNumber = leaf->frames[levelIndex(pageNumber, 0)];
+        if (frameNumber != -1)
+            return static_cast<uint64_t>(frameNumber);
+        return std::nullopt;
+    }
+
+    /**
+     * Updates the table with a new page <> frame mapping, allocating
+     * the path's nodes on first use
+     * @param pageNumber virtual page number
+     * @param frameNumber physical frame number
+     */
+    void setFrameNumber(uint64_t pageNumber, uint64_t frameNumber) {
+        LeafNode *leaf = walk(pageNumber, true);
+        leaf->frames[levelIndex(pageNumber, 0)] = static_cast<int64_t>(frameNumber);
+    }
+
+    /**
+     * Drops a mapping when its page is evicted from physical memory
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint64_t pageNumber) {
+        LeafNode *leaf = walk(pageNumber, false);
+        if (leaf != nullptr) {
+            leaf->frames[levelIndex(pageNumber, 0)] = -1;
+        }
+    }
+
+    /**
+     * Drops every mapping in O(1): the root is cleared and the arena
+     * rewound, so the next trace reuses the warm chunks
+     */
+    void reset() {
+        root.children.fill(nullptr);
+        arena.reset();
+        nodeCount = 0;
+    }
+
+    /** @return interior + leaf nodes allocated so far (memory footprint) */
+    size_t getNodeCount() const {
+        return nodeCount + 1;
+    }
+};
+
+/** @class RadixPageTable16
+ *  @brief Adapter running the simulator's 16-bit space through the radix walk
+ *
+ * Two 4-bit levels over the 8-bit page number - pointless as a space
+ * saver at this size (the flat table wins, and stays the default), but
+ * it exercises the exact walk/lazy-allocation code the 48-bit
+ * configurations use, behind the same interface as PageTable.
+ */
+class RadixPageTable16 {
+  private:
+    RadixPageTable<16, 8, 4> table;
+
+  public:
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        std::optional<uint64_t> frameNumber = table.getFrameNumber(pageNumber);
+        if (frameNumber.has_value())
+            return static_cast<uint8_t>(frameNumber.value());
+        return std::nullopt;
+    }
+
+    void setFrameNumber(uint8_t pageNumber, uint8_t frameNumber) {
+        table.setFrameNumber(pageNumber, frameNumber);
+    }
+
+    void invalidate(uint8_t pageNumber) {
+        table.invalidate(pageNumber);
+    }
+
+    void reset() {
+        table.reset();
+    }
+};
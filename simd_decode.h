@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * Vectorized address decode: splits a block of raw 32-bit logical
+ * addresses into parallel arrays of page numbers and offsets. The
+ * kernel is selected at compile time - AVX2 (32 addresses/iteration),
+ * SSE2 (16/iteration), NEON (16/iteration), or the scalar loop - and
+ * every path computes exactly
+ *     pageNumber = (address >> BITSHIFT) & OFFSET_MASK
+ *     offset     =  address & OFFSET_MASK
+ * so the batched pipeline's lookup stage sees identical inputs
+ * regardless of the instruction set.
+ */
+
+/**
+ * Scalar reference decode, also the tail loop for the SIMD kernels
+ */
+inline void decodeAddressesScalar(const uint32_t *addresses, size_t count,
+                                  uint8_t *pageNumbers, uint8_t *offsets) {
+    for (size_t i = 0; i < count; i++) {
+        pageNumbers[i] = (addresses[i] >> BITSHIFT) & OFFSET_MASK;
+        offsets[i] = addresses[i] & OFFSET_MASK;
+    }
+}
+
+#if defined(__AVX2__)
+
+inline void decodeAddresses(const uint32_t *addresses, size_t count,
+                            uint8_t *pageNumbers, uint8_t *offsets) {
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    // packs work per 128-bit lane; this permute restores sequential
+    // order after the 32 -> 16 -> 8 bit narrowing
+    const __m256i laneFix = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t vectorCount = count / 32;
+    for (size_t block = 0; block < vectorCount; block++) {
+        const __m256i *input = reinterpret_cast<const __m256i *>(addresses + block * 32);
+        __m256i a = _mm256_loadu_si256(input);
+        __m256i b = _mm256_loadu_si256(input + 1);
+        __m256i c = _mm256_loadu_si256(input + 2);
+        __m256i d = _mm256_loadu_si256(input + 3);
+
+        __m256i pageA = _mm256_and_si256(_mm256_srli_epi32(a, BITSHIFT), byteMask);
+        __m256i pageB = _mm256_and_si256(_mm256_srli_epi32(b, BITSHIFT), byteMask);
+        __m256i pageC = _mm256_and_si256(_mm256_srli_epi32(c, BITSHIFT), byteMask);
+        __m256i pageD = _mm256_and_si256(_mm256_srli_epi32(d, BITSHIFT), byteMask);
+
+        __m256i offsetA = _mm256_and_si256(a, byteMask);
+        __m256i offsetB = _mm256_and_si256(b, byteMask);
+        __m256i offsetC = _mm256_and_si256(c, byteMask);
+        __m256i offsetD = _mm256_and_si256(d, byteMask);
+
+        // narrow 32 -> 16 -> 8 bits (values are <= 0xFF, packs are safe)
+        __m256i page = _mm256_packus_epi16(_mm256_packs_epi32(pageA, pageB),
+                                           _mm256_packs_epi32(pageC, pageD));
+        __m256i offset = _mm256_packus_epi16(_mm256_packs_epi32(offsetA, offsetB),
+                                             _mm256_packs_epi32(offsetC, offsetD));
+
+        page = _mm256_permutevar8x32_epi32(page, laneFix);
+        offset = _mm256_permutevar8x32_epi32(offset, laneFix);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pageNumbers + block * 32), page);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(offsets + block * 32), offset);
+    }
+
+    size_t done = vectorCount * 32;
+    decodeAddressesScalar(addresses + done, count - done, pageNumbers + done, offsets + done);
+}
+
+#elif defined(__SSE2__)
+
+inline void decodeAddresses(const uint32_t *addresses, size_t count,
+                            uint8_t *pageNumbers, uint8_t *offsets) {
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+    size_t vectorCount = count / 16;
+    for (size_t block = 0; block < vectorCount; block++) {
+        const __m128i *input = reinterpret_cast<const __m128i *>(addresses + block * 16);
+        __m128i a = _mm_loadu_si128(input);
+        __m128i b = _mm_loadu_si128(input + 1);
+        __m128i c = _mm_loadu_si128(input + 2);
+        __m128i d = _mm_loadu_si128(input + 3);
+
+        __m128i pageA = _mm_and_si128(_mm_srli_epi32(a, BITSHIFT), byteMask);
+        __m128i pageB = _mm_and_si128(_mm_srli_epi32(b, BITSHIFT), byteMask);
+        __m128i pageC = _mm_and_si128(_mm_srli_epi32(c, BITSHIFT), byteMask);
+        __m128i pageD = _mm_and_si128(_mm_srli_epi32(d, BITSHIFT), byteMask);
+
+        __m128i offsetA = _mm_and_si128(a, byteMask);
+        __m128i offsetB = _mm_and_si128(b, byteMask);
+        __m128i offsetC = _mm_and_si128(c, byteMask);
+        __m128i offsetD = _mm_and_si128(d, byteMask);
+
+        // narrow 32 -> 16 -> 8 bits (values are <= 0xFF, packs are safe)
+        __m128i page = _mm_packus_epi16(_mm_packs_epi32(pageA, pageB),
+                                        _mm_packs_epi32(pageC, pageD));
+        __m128i offset = _mm_packus_epi16(_mm_packs_epi32(offsetA, offsetB),
+                                          _mm_packs_epi32(offsetC, offsetD));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pageNumbers + block * 16), page);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(offsets + block * 16), offset);
+    }
+
+    size_t done = vectorCount * 16;
+    decodeAddressesScalar(addresses + done, count - done, pageNumbers + done, offsets + done);
+}
+
+#elif defined(__ARM_NEON)
+
+inline void decodeAddresses(const uint32_t *addresses, size_t count,
+                            uint8_t *pageNumbers, uint8_t *offsets) {
+    size_t vectorCount = count / 16;
+    for (size_t block = 0; block < vectorCount; block++) {
+        const uint32_t *input = addresses + block * 16;
+        uint32x4_t a = vld1q_u32(input);
+        uint32x4_t b = vld1q_u32(input + 4);
+        uint32x4_t c = vld1q_u32(input + 8);
+        uint32x4_t d = vld1q_u32(input + 12);
+
+        // narrowing shifts keep exactly the byte we want per element
+        uint16x8_t pageLow = vcombine_u16(vmovn_u32(vshrq_n_u32(a, BITSHIFT)),
+                                          vmovn_u32(vshrq_n_u32(b, BITSHIFT)));
+        uint16x8_t pageHigh = vcombine_u16(vmovn_u32(vshrq_n_u32(c, BITSHIFT)),
+                                           vmovn_u32(vshrq_n_u32(d, BITSHIFT)));
+        vst1q_u8(pageNumbers + block * 16, vcombine_u8(vmovn_u16(pageLow), vmovn_u16(pageHigh)));
+
+        uint16x8_t offsetLow = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+        uint16x8_t offsetHigh = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+        vst1q_u8(offsets + block * 16, vcombine_u8(vmovn_u16(offsetLow), vmovn_u16(offsetHigh)));
+    }
+
+    size_t done = vectorCount * 16;
+    decodeAddressesScalar(addresses + done, count - done, pageNumbers + done, offsets + done);
+}
+
+#else
+
+inline void decodeAddresses(const uint32_t *addresses, size_t count,
+                            uint8_t *pageNumbers, uint8_t *offsets) {
+    decodeAddressesScalar(addresses, count, pageNumbers, offsets);
+}
+
+#endif
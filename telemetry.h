@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <cstdint>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/** @struct TelemetrySample
+ *  @brief One snapshot of the replay counters
+ */
+struct TelemetrySample {
+    long totalAddresses = 0;
+    long tlbHits = 0;
+    long pageFaults = 0;
+};
+
+/** @class TelemetryServer
+ *  @brief Live progress telemetry for long replays
+ *
+ * A multi-hour replay is no longer a black box until the final two
+ * printouts: a dedicated stats thread snapshots the engine's counters
+ * every interval - the hot loop is never touched, the counters are
+ * read from outside - and publishes three ways:
+ *
+ *  - a status line on stderr (throughput, rolling TLB hit and fault
+ *    rates over the last interval, ETA when the trace length is known)
+ *  - a CSV time series (telemetry.csv) for offline inspection
+ *  - an optional local TCP endpoint: connect, read one status line,
+ *    done - trivially scrapable by a dashboard
+ */
+class TelemetryServer {
+  private:
+    std::function<TelemetrySample()> snapshot;
+    double intervalSeconds;
+    long expectedTotal = 0; // 0 -> unknown, no ETA
+
+    std::ofstream csv;
+    int listenFd = -1;
+
+    std::thread statsThread;
+    std::atomic<bool> shuttingDown{false};
+
+    TelemetrySample lastSample;
+    std::chrono::steady_clock::time_point lastTime;
+    std::chrono::steady_clock::time_point startTime;
+
+    /**
+     * Builds one status line from the delta since the last snapshot
+     */
+    std::string formatStatus(const TelemetrySample &sample, double elapsed, double sinceLast) {
+        long deltaAddresses = sample.totalAddresses - lastSample.totalAddresses;
+        long deltaHits = sample.tlbHits - lastSample.tlbHits;
+        long deltaFaults = sample.pageFaults - lastSample.pageFaults;
+
+        // a counter reset (next trace of a batch) makes the deltas
+        // negative; report the interval as a fresh start instead
+        if (deltaAddresses < 0) {
+            deltaAddresses = sample.totalAddresses;
+            deltaHits = sample.tlbHits;
+            deltaFaults = sample.pageFaults;
+        }
+
+        double throughput = sinceLast > 0 ? deltaAddresses / sinceLast : 0.0;
+        double rollingHitRate = deltaAddresses > 0 ? 100.0 * deltaHits / deltaAddresses : 0.0;
+        double rollingFaultRate = deltaAddresses > 0 ? 100.0 * deltaFaults / deltaAddresses : 0.0;
+
+        std::ostringstream line;
+        line << "[telemetry] t=" << static_cast<long>(elapsed) << "s addresses="
+             << sample.totalAddresses << " addr/s=" << static_cast<long>(throughput)
+             << " rolling_tlb_hit=" << rollingHitRate << "% rolling_fault="
+             << rollingFaultRate << "%";
+        if (expectedTotal > 0 && throughput > 0 && sample.totalAddresses < expectedTotal) {
+            double eta = (expectedTotal - sample.totalAddresses) / throughput;
+            line << " eta=" << static_cast<long>(eta) << "s";
+        }
+        return line.str();
+    }
+
+    /**
+     * Stats thread body: sample, publish, answer scrapes, sleep
+     */
+    void statsLoop() {
+        std::string lastStatus;
+
+        while (!shuttingDown.load()) {
+            // the listen socket doubles as the interval timer: wait on
+            // it with the interval as the select timeout
+            if (listenFd >= 0) {
+                fd_set readSet;
+                FD_ZERO(&readSet);
+                FD_SET(listenFd, &readSet);
+                struct timeval timeout{};
+                timeout.tv_sec = static_cast<long>(intervalSeconds);
+                timeout.tv_usec = static_cast<long>((intervalSeconds - timeout.tv_sec) * 1e6);
+                if (select(listenFd + 1, &readSet, nullptr, nullptr, &timeout) > 0) {
+                    int scraper = accept(listenFd, nullptr, nullptr);
+                    if (scraper >= 0) {
+                        std::string reply = lastStatus + "\n";
+                        ssize_t written = write(scraper, reply.data(), reply.size());
+                        (void)written;
+                        close(scraper);
+                    }
+                    continue; // re-check the interval after a scrape
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::duration<double>(intervalSeconds));
+            }
+            if (shuttingDown.load())
+                return;
+
+            auto now = std::chrono::steady_clock::now();
+            TelemetrySample sample = snapshot();
+            double elapsed = std::chrono::duration<double>(now - startTime).count();
+            double sinceLast = std::chrono::duration<double>(now - lastTime).count();
+
+            lastStatus = formatStatus(sample, elapsed, sinceLast);
+            std::cerr << lastStatus << std::endl;
+
+            if (csv.is_open()) {
+                long deltaAddresses = sample.totalAddresses - lastSample.totalAddresses;
+                if (deltaAddresses < 0)
+                    deltaAddresses = sample.totalAddresses;
+                csv << elapsed << "," << sample.totalAddresses << ","
+                    << (sinceLast > 0 ? deltaAddresses / sinceLast : 0.0) << ","
+                    << sample.tlbHits << "," << sample.pageFaults << "\n";
+                csv.flush();
+            }
+
+            lastSample = sample;
+            lastTime = now;
+        }
+    }
+
+  public:
+    /**
+     * Constructor: start the stats thread (and the scrape endpoint)
+     * @param snapshot reads the current counters; called off the hot path
+     * @param intervalSeconds publishing cadence
+     * @param port local TCP scrape port, 0 -> no endpoint
+     */
+    TelemetryServer(std::function<TelemetrySample()> snapshot, double intervalSeconds,
+                    uint16_t port = 0)
+        : snapshot(std::move(snapshot)), intervalSeconds(intervalSeconds) {
+        csv.open("telemetry.csv");
+        if (csv) {
+            csv << "elapsed_s,total_addresses,addr_per_s,tlb_hits,page_faults\n";
+        }
+
+        if (port != 0) {
+            listenFd = socket(AF_INET, SOCK_STREAM, 0);
+            if (listenFd >= 0) {
+                int reuse = 1;
+                setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+                struct sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                address.sin_port = htons(port);
+                if (bind(listenFd, reinterpret_cast<struct sockaddr *>(&address),
+                         sizeof(address)) != 0 ||
+                    listen(listenFd, 4) != 0) {
+                    std::cerr << "Warning: telemetry endpoint unavailable on port " << port
+                              << std::endl;
+                    close(listenFd);
+                    listenFd = -1;
+                }
+            }
+        }
+
+        startTime = std::chrono::steady_clock::now();
+        lastTime = startTime;
+        statsThread = std::thread(&TelemetryServer::statsLoop, this);
+    }
+
+    /**
+     * Destructor: stop the stats thread and close the endpoint
+     */
+    ~TelemetryServer() {
+        shuttingDown.store(true);
+        statsThread.join();
+        if (listenFd >= 0) {
+            close(listenFd);
+        }
+    }
+
+    /**
+     * Announces the trace length so the status line can carry an ETA
+     */
+    void setExpectedTotal(long total) {
+        expectedTotal = total;
+    }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+#include "vmm_config.h"
+
+/** @class TLB
+ *  @brief Translational Lookaside Buffer implementation
+ *
+ * Purpose: To provide a fast cache for page number to frame number translation
+ *
+ */
+class TLB {
+  private:
+    // internal storage for TLB entries
+    // using deque to facilitate FIFO replacement strategy
+    // entry -> pair of <page number, frame number>
+    std::deque<std::pair<uint8_t, uint8_t>> tlbEntries;
+
+  public:
+    /**
+     * Searches for a page number in the TLB
+     * @param pageNumber the virtual page number to lookup
+     * @return optional frame number on TLB hit, empty otherwise
+     */
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        // iterate through the TLB to find a matching page number
+        for (auto iterator = tlbEntries.begin(); iterator != tlbEntries.end(); ++iterator) {
+            if (iterator->first == pageNumber) {
+                // got it, capture frame
+                uint8_t frameNumber = iterator->second;
+
+                // remove current entry and add it to the back
+                // make it work like LRU
+                tlbEntries.erase(iterator);
+                tlbEntries.emplace_back(pageNumber, frameNumber);
+                return frameNumber;
+            }
+        }
+        return std::nullopt; // TLB miss
+    }
+
+    /**
+     * This func adds a new entry to the TLB, while managing capacity
+     * @param pageNumber virtual page number to add
+     * @param frameNumber corresponding physical frame number
+     */
+    void addEntry(uint8_t pageNumber, uint8_t frameNumber) {
+
+        // remove any existing entry for the same page to prevent duplicates
+        auto iterator = std::find_if(tlbEntries.begin(), tlbEntries.end(),
+                                     [&](const auto &entry) { return entry.first == pageNumber; });
+        if (iterator != tlbEntries.end()) {
+            tlbEntries.erase(iterator);
+        }
+
+        // enforce TLB size limit using FIFO
+        if (tlbEntries.size() >= TLB_SIZE) {
+            tlbEntries.pop_front(); // nuke the oldest entry
+        }
+
+        // add new entry to the end of queue
+        tlbEntries.emplace_back(pageNumber, frameNumber);
+    }
+
+    /**
+     * Drops the entry for a page evicted from physical memory
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint8_t pageNumber) {
+        auto iterator = std::find_if(tlbEntries.begin(), tlbEntries.end(),
+                                     [&](const auto &entry) { return entry.first == pageNumber; });
+        if (iterator != tlbEntries.end()) {
+            tlbEntries.erase(iterator);
+        }
+    }
+
+    /**
+     * Empties the TLB (next trace in a batch starts cold)
+     */
+    void reset() {
+        tlbEntries.clear();
+    }
+
+    /**
+     * @return cached entries in recency order, oldest first
+     */
+    std::vector<std::pair<uint8_t, uint8_t>> snapshot() const {
+        return {tlbEntries.begin(), tlbEntries.end()};
+    }
+
+    /**
+     * Rebuilds the TLB from a snapshot (oldest entry first)
+     */
+    void restore(const std::vector<std::pair<uint8_t, uint8_t>> &entries) {
+        reset();
+        for (const auto &[pageNumber, frameNumber] : entries) {
+            addEntry(pageNumber, frameNumber);
+        }
+    }
+};
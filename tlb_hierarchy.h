@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <sstream>
+#include <string>
+#include <cstdint>
+
+#include "vmm_config.h"
+
+// hierarchy geometry, modeled on the deployment hardware:
+// 64-entry direct-mapped L1 backed by a 1536-entry 12-way L2
+#define L1_TLB_SIZE 64
+#define L2_TLB_SETS 128
+#define L2_TLB_WAYS 12
+
+// cycle cost model per probe outcome
+#define L1_HIT_CYCLES 1
+#define L2_HIT_CYCLES 7
+#define TLB_MISS_CYCLES 30
+
+/** @class TlbHierarchy
+ *  @brief Two-level TLB: direct-mapped L1 probed first, set-associative L2 behind it
+ *
+ * Models the deployed hardware instead of a single flat TLB, so hit
+ * rates from the simulator predict production behavior. The L1 probe
+ * is a single array index; on an L1 miss the L2 set (page number
+ * modulo L2_TLB_SETS) is searched associatively and a hit is promoted
+ * into L1. Entries are inserted into both levels (inclusive).
+ *
+ * Every lookup also charges a configurable cycle cost - L1 hit, L1
+ * miss + L2 hit, or full miss (modeling the page walk) - so a replay
+ * reports an estimated total translation cycle count, not just the
+ * flat hit-rate percentage. Per-level hit/miss counters feed the same
+ * report.
+ *
+ * Exposes the common TLB interface (getFrameNumber/addEntry/
+ * invalidate/reset), so the engine runs it like any other TLB via
+ * --tlb=hierarchy.
+ */
+class TlbHierarchy {
+  private:
+    struct Entry {
+        int16_t pageNumber = -1; // -1 -> invalid
+        uint8_t frameNumber = 0;
+        uint64_t lastUsed = 0; // recency stamp for the L2 ways
+    };
+
+    // L1: direct-mapped by the page number's low bits
+    std::array<Entry, L1_TLB_SIZE> l1{};
+
+    // L2: set-associative, LRU within each set via recency stamps
+    std::array<std::array<Entry, L2_TLB_WAYS>, L2_TLB_SETS> l2{};
+
+    // monotonic stamp source for the L2 LRU
+    uint64_t tick = 0;
+
+    // per-level counters and the accumulated cost model
+    long l1Hits = 0;
+    long l2Hits = 0;
+    long misses = 0;
+    uint64_t estimatedCycles = 0;
+
+    static unsigned l1Index(uint8_t pageNumber) { return pageNumber % L1_TLB_SIZE; }
+    static unsigned l2Set(uint8_t pageNumber) { return pageNumber % L2_TLB_SETS; }
+
+    /** Installs a mapping into its L1 slot (displacing whatever was there) */
+    void fillL1(uint8_t pageNumber, uint8_t frameNumber) {
+        Entry &slot = l1[l1Index(pageNumber)];
+        slot.pageNumber = pageNumber;
+        slot.frameNumber = frameNumber;
+    }
+
+    /** Installs a mapping into its L2 set, evicting the set's LRU way */
+    void fillL2(uint8_t pageNumber, uint8_t frameNumber) {
+        auto &set = l2[l2Set(pageNumber)];
+        Entry *victim = &set[0];
+        for (Entry &way : set) {
+            if (way.pageNumber == pageNumber) {
+                victim = &way; // refresh in place, no duplicate ways
+                break;
+            }
+            if (way.pageNumber == -1) {
+                victim = &way; // free way beats evicting
+                break;
+            }
+            if (way.lastUsed < victim->lastUsed) {
+                victim = &way;
+            }
+        }
+        victim->pageNumber = pageNumber;
+        victim->frameNumber = frameNumber;
+        victim->lastUsed = ++tick;
+    }
+
+  public:
+    /**
+     * Probes L1 then L2, promoting L2 hits and charging the cost model
+     * @param pageNumber the virtual page number to lookup
+     * @return optional frame number on a hit at either level
+     */
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        Entry &l1Slot = l1[l1Index(pageNumber)];
+        if (l1Slot.pageNumber == pageNumber) {
+            l1Hits++;
+            estimatedCycles += L1_HIT_CYCLES;
+            return l1Slot.frameNumber;
+        }
+
+        auto &set = l2[l2Set(pageNumber)];
+        for (Entry &way : set) {
+            if (way.pageNumber == pageNumber) {
+                l2Hits++;
+                estimatedCycles += L1_HIT_CYCLES + L2_HIT_CYCLES;
+                way.lastUsed = ++tick;
+                // promote into L1 so the next probe is one index
+                fillL1(pageNumber, way.frameNumber);
+                return way.frameNumber;
+            }
+        }
+
+        misses++;
+        estimatedCycles += L1_HIT_CYCLES + L2_HIT_CYCLES + TLB_MISS_CYCLES;
+        return std::nullopt;
+    }
+
+    /**
+     * Inserts a mapping into both levels (inclusive hierarchy)
+     * @param pageNumber virtual page number to add
+     * @param frameNumber corresponding physical frame number
+     */
+    void addEntry(uint8_t pageNumber, uint8_t frameNumber) {
+        fillL1(pageNumber, frameNumber);
+        fillL2(pageNumber, frameNumber);
+    }
+
+    /**
+     * Drops the entry for a page evicted from physical memory
+     * @param pageNumber virtual page number to invalidate
+     */
+    void invalidate(uint8_t pageNumber) {
+        Entry &l1Slot = l1[l1Index(pageNumber)];
+        if (l1Slot.pageNumber == pageNumber) {
+            l1Slot.pageNumber = -1;
+        }
+        for (Entry &way : l2[l2Set(pageNumber)]) {
+            if (way.pageNumber == pageNumber) {
+                way.pageNumber = -1;
+            }
+        }
+    }
+
+    /**
+     * Empties both levels and the counters (next trace starts cold)
+     */
+    void reset() {
+        l1.fill(Entry{});
+        for (auto &set : l2)
+            set.fill(Entry{});
+        tick = 0;
+        l1Hits = 0;
+        l2Hits = 0;
+        misses = 0;
+        estimatedCycles = 0;
+    }
+
+    /**
+     * @return cached entries ordered by L2 recency, oldest first
+     * (checkpoint support; L1 placement is rebuilt by restore())
+     */
+    std::vector<std::pair<uint8_t, uint8_t>> snapshot() const {
+        std::vector<std::pair<uint8_t, uint8_t>> result;
+        std::vector<std::pair<uint64_t, std::pair<uint8_t, uint8_t>>> stamped;
+        for (const auto &set : l2) {
+            for (const Entry &way : set) {
+                if (way.pageNumber != -1) {
+                    stamped.emplace_back(way.lastUsed,
+                                         std::make_pair(static_cast<uint8_t>(way.pageNumber),
+                                                        way.frameNumber));
+                }
+            }
+        }
+        std::sort(stamped.begin(), stamped.end());
+        result.reserve(stamped.size());
+        for (const auto &[stamp, entry] : stamped) {
+            result.push_back(entry);
+        }
+        return result;
+    }
+
+    /**
+     * Rebuilds both levels from a snapshot (oldest entry first);
+     * counters and the cycle estimate restart from zero
+     */
+    void restore(const std::vector<std::pair<uint8_t, uint8_t>> &entries) {
+        reset();
+        for (const auto &[pageNumber, frameNumber] : entries) {
+            addEntry(pageNumber, frameNumber);
+        }
+    }
+
+    /**
+     * Formats the per-level counters and the cycle estimate, appended
+     * to the replay's standard statistics
+     */
+    std::string formatStats() const {
+        long lookups = l1Hits + l2Hits + misses;
+        std::ostringstream stats;
+        stats << "L1 TLB Hit Rate = " << (lookups > 0 ? 100.0 * l1Hits / lookups : 0.0) << "%" << '\n';
+        stats << "L2 TLB Hit Rate = " << (lookups > 0 ? 100.0 * l2Hits / lookups : 0.0) << "%" << '\n';
+        stats << "Estimated Translation Cycles = " << estimatedCycles << '\n';
+        return stats.str();
+    }
+};
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "workload_gen.h"
+
+// cycle cost model for the policy comparison report
+#define TLB_POLICY_HIT_CYCLES 1
+#define TLB_POLICY_MISS_CYCLES 30
+
+/** @class TlbPolicy
+ *  @brief Replacement strategy interface for PolicyTLB
+ *
+ * Strategies reason over slot indices (0..TLB_SIZE-1) plus the page
+ * number, which the adaptive strategies need for ghost tracking.
+ */
+class TlbPolicy {
+  public:
+    virtual ~TlbPolicy() = default;
+
+    /** The entry in this slot was hit */
+    virtual void onHit(int slot) = 0;
+
+    /** A new page was installed into this slot */
+    virtual void onInsert(int slot, uint8_t pageNumber) = 0;
+
+    /** Pick the slot to evict; called only when every slot is in use */
+    virtual int selectVictim() = 0;
+
+    /** The page previously held by an evicted/invalidated slot left
+     *  the TLB (ghost-tracking hook; most policies ignore it) */
+    virtual void onEvict(uint8_t) {}
+
+    /** Back to empty (trace reset) */
+    virtual void reset() = 0;
+};
+
+/** @class SlotList
+ *  @brief Intrusive doubly-linked list over TLB slots (shared helper)
+ */
+class SlotList {
+  private:
+    std::vector<int16_t> prev;
+    std::vector<int16_t> next;
+    int16_t headSlot = -1;
+    int16_t tailSlot = -1;
+    size_t count = 0;
+
+  public:
+    explicit SlotList(size_t capacity) : prev(capacity, -1), next(capacity, -1) {}
+
+    void pushBack(int slot) {
+        prev[slot] = tailSlot;
+        next[slot] = -1;
+        if (tailSlot != -1)
+            next[tailSlot] = slot;
+        else
+            headSlot = slot;
+        tailSlot = static_cast<int16_t>(slot);
+        count++;
+    }
+
+    void remove(int slot) {
+        if (prev[slot] != -1)
+            next[prev[slot]] = next[slot];
+        else
+            headSlot = next[slot];
+        if (next[slot] != -1)
+            prev[next[slot]] = prev[slot];
+        else
+            tailSlot = prev[slot];
+        count--;
+    }
+
+    int head() const { return headSlot; }
+    size_t size() const { return count; }
+
+    void clear() {
+        std::fill(prev.begin(), prev.end(), -1);
+        std::fill(next.begin(), next.end(), -1);
+        headSlot = -1;
+        tailSlot = -1;
+        count = 0;
+    }
+};
+
+/** @class LruTlbPolicy
+ *  @brief Plain LRU over one recency list
+ */
+class LruTlbPolicy : public TlbPolicy {
+  private:
+    SlotList recency;
+
+  public:
+    LruTlbPolicy() : recency(TLB_SIZE) {}
+
+    void onHit(int slot) override {
+        recency.remove(slot);
+        recency.pushBack(slot);
+    }
+
+    void onInsert(int slot, uint8_t) override {
+        recency.pushBack(slot);
+    }
+
+    int selectVictim() override {
+        int victim = recency.head();
+        recency.remove(victim);
+        return victim;
+    }
+
+    void reset() override {
+        recency.clear();
+    }
+};
+
+/** @class SlruTlbPolicy
+ *  @brief Segmented LRU: probation + protected segments
+ *
+ * Inserts land in probation; a probation hit promotes the entry into
+ * the protected segment (capacity TLB_SIZE/2, overflow demotes its LRU
+ * back to probation). Victims come from probation first, so pages
+ * touched once cannot flush the proven-hot protected set - the
+ * scan-resistance our skewed traces want.
+ */
+class SlruTlbPolicy : public TlbPolicy {
+  private:
+    static constexpr size_t PROTECTED_CAPACITY = TLB_SIZE / 2;
+
+    SlotList probation;
+    SlotList protectedSegment;
+    std::vector<uint8_t> inProtected;
+
+  public:
+    SlruTlbPolicy() : probation(TLB_SIZE), protectedSegment(TLB_SIZE), inProtected(TLB_SIZE, 0) {}
+
+    void onHit(int slot) override {
+        if (inProtected[slot]) {
+            protectedSegment.remove(slot);
+            protectedSegment.pushBack(slot);
+            return;
+        }
+
+        // promote out of probation
+        probation.remove(slot);
+        if (protectedSegment.size() >= PROTECTED_CAPACITY) {
+            // demote the protected LRU back to probation
+            int demoted = protectedSegment.head();
+            protectedSegment.remove(demoted);
+            inProtected[demoted] = 0;
+            probation.pushBack(demoted);
+        }
+        protectedSegment.pushBack(slot);
+        inProtected[slot] = 1;
+    }
+
+    void onInsert(int slot, uint8_t) override {
+        probation.pushBack(slot);
+        inProtected[slot] = 0;
+    }
+
+    int selectVictim() override {
+        // probation first; fall back to protected only when empty
+        int victim = probation.size() > 0 ? probation.head() : protectedSegment.head();
+        if (inProtected[victim]) {
+            protectedSegment.remove(victim);
+            inProtected[victim] = 0;
+        } else {
+            probation.remove(victim);
+        }
+        return victim;
+    }
+
+    void reset() override {
+        probation.clear();
+        protectedSegment.clear();
+        std::fill(inProtected.begin(), inProtected.end(), 0);
+    }
+};
+
+/** @class TwoQTlbPolicy
+ *  @brief 2Q-style adaptive policy with a ghost list
+ *
+ * First-time pages enter a FIFO (A1in); pages whose number is still on
+ * the ghost list of recent evictions (A1out) are considered re-used
+ * and enter the LRU main list (Am) directly. Victims drain A1in while
+ * it holds more than its quarter-capacity target, otherwise Am's LRU -
+ * so one-shot streams wash through the FIFO without disturbing the
+ * main list, and genuinely re-referenced pages are kept.
+ */
+class TwoQTlbPolicy : public TlbPolicy {
+  private:
+    static constexpr size_t A1IN_TARGET = TLB_SIZE / 4 > 0 ? TLB_SIZE / 4 : 1;
+    static constexpr size_t GHOST_CAPACITY = TLB_SIZE;
+
+    SlotList a1in; // FIFO of first-timers
+    SlotList am;   // LRU of proven re-used pages
+    std::vector<uint8_t> inAm;
+
+    // ghost list of recently evicted page numbers (ring buffer + map)
+    std::vector<int16_t> ghostRing;
+    std::array<uint8_t, PAGE_TABLE_SIZE> ghostMember{};
+    size_t ghostCursor = 0;
+
+    void addGhost(uint8_t pageNumber) {
+        int16_t displaced = ghostRing[ghostCursor];
+        if (displaced != -1)
+            ghostMember[displaced] = 0;
+        ghostRing[ghostCursor] = pageNumber;
+        ghostMember[pageNumber] = 1;
+        ghostCursor = (ghostCursor + 1) % GHOST_CAPACITY;
+    }
+
+  public:
+    TwoQTlbPolicy()
+        : a1in(TLB_SIZE), am(TLB_SIZE), inAm(TLB_SIZE, 0), ghostRing(GHOST_CAPACITY, -1) {}
+
+    void onHit(int slot) override {
+        if (inAm[slot]) {
+            am.remove(slot);
+            am.pushBack(slot);
+        }
+        // 2Q leaves A1in order untouched on hit (FIFO semantics)
+    }
+
+    void onInsert(int slot, uint8_t pageNumber) override {
+        if (ghostMember[pageNumber]) {
+            // recently evicted and back again: straight into the main list
+            ghostMember[pageNumber] = 0;
+            am.pushBack(slot);
+            inAm[slot] = 1;
+        } else {
+            a1in.pushBack(slot);
+            inAm[slot] = 0;
+        }
+    }
+
+    int selectVictim() override {
+        int victim;
+        if (a1in.size() > A1IN_TARGET || am.size() == 0) {
+            victim = a1in.head();
+            a1in.remove(victim);
+        } else {
+            victim = am.head();
+            am.remove(victim);
+            inAm[victim] = 0;
+        }
+        return victim;
+    }
+
+    void onEvict(uint8_t pageNumber) override {
+        addGhost(pageNumber);
+    }
+
+    void reset() override {
+        a1in.clear();
+        am.clear();
+        std::fill(inAm.begin(), inAm.end(), 0);
+        std::fill(ghostRing.begin(), ghostRing.end(), -1);
+        ghostMember.fill(0);
+        ghostCursor = 0;
+    }
+};
+
+/** @class RandomTlbPolicy
+ *  @brief Evicts a uniformly random slot (the baseline to beat)
+ */
+class RandomTlbPolicy : public TlbPolicy {
+  private:
+    Xorshift rng;
+
+  public:
+    RandomTlbPolicy() : rng(0xD1CE) {}
+
+    void onHit(int) override {}
+    void onInsert(int, uint8_t) override {}
+
+    int selectVictim() override {
+        return static_cast<int>(rng.next() % TLB_SIZE);
+    }
+
+    void reset() override {
+        rng = Xorshift(0xD1CE);
+    }
+};
+
+/** @class PolicyTLB
+ *  @brief Indexed TLB with a runtime-pluggable replacement strategy
+ *
+ * Same O(1) direct-mapped index as IndexedTLB, but recency/eviction
+ * decisions are delegated to a TlbPolicy, so strategies can be
+ * compared without forking the TLB. Tracks its own hit/lookup
+ * counters and an estimated cycle cost for the comparison report.
+ */
+class PolicyTLB {
+  private:
+    struct Entry {
+        uint8_t pageNumber;
+        uint8_t frameNumber;
+        bool valid;
+    };
+
+    std::array<Entry, TLB_SIZE> entries{};
+    std::array<int16_t, PAGE_TABLE_SIZE> index{};
+    int usedSlots = 0;
+
+    std::unique_ptr<TlbPolicy> policy;
+    std::string policyName;
+
+    long lookups = 0;
+    long hits = 0;
+
+    static std::unique_ptr<TlbPolicy> makePolicy(const std::string &name) {
+        if (name == "lru")
+            return std::make_unique<LruTlbPolicy>();
+        if (name == "slru")
+            return std::make_unique<SlruTlbPolicy>();
+        if (name == "2q")
+            return std::make_unique<TwoQTlbPolicy>();
+        if (name == "random")
+            return std::make_unique<RandomTlbPolicy>();
+        std::cerr << "Unknown TLB replacement policy: " << name << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+  public:
+    explicit PolicyTLB(const std::string &name)
+        : policy(makePolicy(name)), policyName(name) {
+        index.fill(-1);
+    }
+
+    std::optional<uint8_t> getFrameNumber(uint8_t pageNumber) {
+        lookups++;
+        int16_t slot = index[pageNumber];
+        if (slot == -1)
+            return std::nullopt;
+        hits++;
+        policy->onHit(slot);
+        return entries[slot].frameNumber;
+    }
+
+    void addEntry(uint8_t pageNumber, uint8_t frameNumber) {
+        int16_t slot = index[pageNumber];
+        if (slot != -1) {
+            entries[slot].frameNumber = frameNumber;
+            policy->onHit(slot);
+            return;
+        }
+
+        if (usedSlots < static_cast<int>(TLB_SIZE)) {
+            slot = static_cast<int16_t>(usedSlots++);
+        } else {
+            // full: the strategy picks the victim slot
+            slot = static_cast<int16_t>(policy->selectVictim());
+            if (entries[slot].valid) {
+                index[entries[slot].pageNumber] = -1;
+                policy->onEvict(entries[slot].pageNumber);
+            }
+        }
+
+        entries[slot].pageNumber = pageNumber;
+        entries[slot].frameNumber = frameNumber;
+        entries[slot].valid = true;
+        index[pageNumber] = slot;
+        policy->onInsert(slot, pageNumber);
+    }
+
+    void invalidate(uint8_t pageNumber) {
+        int16_t slot = index[pageNumber];
+        if (slot == -1)
+            return;
+        // drop the mapping; the slot stays policy-owned and is
+        // reclaimed through normal victim selection when needed
+        index[pageNumber] = -1;
+        entries[slot].valid = false;
+        policy->onEvict(pageNumber);
+    }
+
+    void reset() {
+        index.fill(-1);
+        usedSlots = 0;
+        policy->reset();
+        lookups = 0;
+        hits = 0;
+    }
+
+    std::vector<std::pair<uint8_t, uint8_t>> snapshot() const {
+        std::vector<std::pair<uint8_t, uint8_t>> result;
+        for (int slot = 0; slot < usedSlots; slot++) {
+            if (entries[slot].valid) {
+                result.emplace_back(entries[slot].pageNumber, entries[slot].frameNumber);
+            }
+        }
+        return result;
+    }
+
+    void restore(const std::vector<std::pair<uint8_t, uint8_t>> &savedEntries) {
+        reset();
+        for (const auto &[pageNumber, frameNumber] : savedEntries) {
+            addEntry(pageNumber, frameNumber);
+        }
+    }
+
+    const std::string &getPolicyName() const { return policyName; }
+    long getLookups() const { return lookups; }
+    long getHits() const { return hits; }
+
+    /** Estimated cycles under the simple hit/miss cost model */
+    uint64_t getEstimatedCycles() const {
+        return static_cast<uint64_t>(hits) * TLB_POLICY_HIT_CYCLES +
+               static_cast<uint64_t>(lookups - hits) *
+                       (TLB_POLICY_HIT_CYCLES + TLB_POLICY_MISS_CYCLES);
+    }
+};
+
+// default-constructible wrappers so the replay templates can
+// instantiate one engine per strategy (--tlb=lru|slru|2q|random)
+struct LruPolicyTLB : PolicyTLB {
+    LruPolicyTLB() : PolicyTLB("lru") {}
+};
+struct SlruPolicyTLB : PolicyTLB {
+    SlruPolicyTLB() : PolicyTLB("slru") {}
+};
+struct TwoQPolicyTLB : PolicyTLB {
+    TwoQPolicyTLB() : PolicyTLB("2q") {}
+};
+struct RandomPolicyTLB : PolicyTLB {
+    RandomPolicyTLB() : PolicyTLB("random") {}
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vmm_config.h"
+
+// records per stream buffer (4 MiB each); two buffers in flight
+#define STREAM_BUFFER_RECORDS (1 << 20)
+
+/** @class StreamingTraceReader
+ *  @brief Double-buffered overlapped reader for packed binary traces
+ *
+ * Alternative to mmap for bulk replays where the OS cache is cold: a
+ * background thread fills the next large buffer with pread while the
+ * replay engine consumes the current one, so trace ingest bandwidth
+ * overlaps with translation instead of stalling it. The two buffers
+ * are pinned (mlock, best effort) so the fill never page-faults.
+ *
+ * Usage: call nextBlock() until it returns an empty span (EOF).
+ * Returned spans stay valid until the following nextBlock() call.
+ */
+class StreamingTraceReader {
+  private:
+    enum class SlotState { EMPTY, FILLING, READY, DRAINED };
+
+    struct Slot {
+        std::vector<uint32_t> buffer;
+        size_t recordCount = 0;
+        SlotState state = SlotState::EMPTY;
+    };
+
+    int fd = -1;
+    off_t fileOffset = 0;
+
+    Slot slots[2];
+    int consumeSlot = 0; // next slot the consumer takes
+    int currentSlot = -1; // slot currently lent out to the consumer
+
+    std::mutex mutex;
+    std::condition_variable slotReady;
+    std::condition_variable slotFree;
+    std::thread readerThread;
+    bool shuttingDown = false;
+
+    /**
+     * Reader thread body: keep the free slot filled until EOF
+     */
+    void readerLoop() {
+        int fillSlot = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            slotFree.wait(lock, [&] {
+                return slots[fillSlot].state == SlotState::EMPTY || shuttingDown;
+            });
+            if (shuttingDown)
+                return;
+
+            Slot &slot = slots[fillSlot];
+            slot.state = SlotState::FILLING;
+
+            lock.unlock();
+            ssize_t bytes = pread(fd, slot.buffer.data(),
+                                  STREAM_BUFFER_RECORDS * sizeof(uint32_t), fileOffset);
+            lock.lock();
+
+            if (bytes < 0) {
+                std::cerr << "Error reading binary trace stream" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            fileOffset += bytes;
+            slot.recordCount = static_cast<size_t>(bytes) / sizeof(uint32_t);
+            slot.state = SlotState::READY;
+            slotReady.notify_one();
+
+            if (slot.recordCount == 0) {
+                return; // EOF slot handed over, nothing left to do
+            }
+            fillSlot ^= 1;
+        }
+    }
+
+  public:
+    /**
+     * Constructor: open the trace and start the fill thread
+     * @param fileName packed binary trace path
+     *
+     * Terminate if the file cannot be opened or is misaligned
+     */
+    explicit StreamingTraceReader(const std::string &fileName) {
+        fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Error opening address file: " << fileName << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size % sizeof(uint32_t) != 0) {
+            std::cerr << "Error: " << fileName << " is not a valid binary trace" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        for (Slot &slot : slots) {
+            slot.buffer.resize(STREAM_BUFFER_RECORDS);
+            // pin so the background fill never page-faults (best effort)
+            mlock(slot.buffer.data(), STREAM_BUFFER_RECORDS * sizeof(uint32_t));
+        }
+
+        readerThread = std::thread(&StreamingTraceReader::readerLoop, this);
+    }
+
+    /**
+     * Destructor: stop the fill thread and release the buffers
+     */
+    ~StreamingTraceReader() {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            shuttingDown = true;
+        }
+        slotFree.notify_one();
+        readerThread.join();
+        for (Slot &slot : slots) {
+            munlock(slot.buffer.data(), STREAM_BUFFER_RECORDS * sizeof(uint32_t));
+        }
+        close(fd);
+    }
+
+    /**
+     * Hands back the previous block and blocks until the next is ready
+     * @return the next block of records; empty at end of trace
+     */
+    std::span<const uint32_t> nextBlock() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // release the block the consumer just finished
+        if (currentSlot != -1) {
+            slots[currentSlot].state = SlotState::EMPTY;
+            slotFree.notify_one();
+        }
+
+        slotReady.wait(lock, [&] { return slots[consumeSlot].state == SlotState::READY; });
+
+        currentSlot = consumeSlot;
+        Slot &slot = slots[currentSlot];
+        slot.state = SlotState::DRAINED;
+        if (slot.recordCount > 0) {
+            consumeSlot ^= 1;
+        }
+        return {slot.buffer.data(), slot.recordCount};
+    }
+};
@@ -0,0 +1,577 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "tlb.h"
+#include "page_table.h"
+#include "radix_page_table.h"
+#include "physical_memory.h"
+#include "backing_store.h"
+#include "frame_allocator.h"
+#include "write_back.h"
+#include "checkpoint.h"
+#include "page_stats.h"
+#include "async_fault.h"
+#include "compressed_cache.h"
+#include "dedup.h"
+#include "instrumentation.h"
+#include "simd_decode.h"
+
+/** @struct TranslationResult
+ *  @brief One fully resolved translation produced by the batched pipeline
+ */
+struct TranslationResult {
+    uint16_t logicalAddress;  // masked 16-bit logical address
+    uint16_t physicalAddress; // frame number << 8 | offset
+    int8_t value;             // byte stored at the physical address
+};
+
+// a trace record with the top bit set is a store: the address's low
+// byte is written to the translated location (and the frame is marked
+// dirty); records without it are loads, as before
+#define TRACE_WRITE_BIT 0x80000000u
+
+/** @class TranslationEngine
+ *  @brief Batched address-translation pipeline
+ *
+ * Templated over the TLB implementation (deque-based or indexed) and
+ * the page table (flat PageTable for the dense 16-bit space, or the
+ * radix adapter for exercising the multi-level walk) - each pair
+ * exposes the same lookup interface, so the pipeline is unchanged.
+ *
+ * Purpose: To run the parse/translate/fault/emit stages over whole batches
+ * instead of interleaving them per address. A batch flows through distinct
+ * stages:
+ *   1. decode    - split every logical address into page number + offset
+ *   2. lookup    - resolve TLB/page-table for the whole block, queue faults
+ *   3. fault     - service all queued page loads from the backing store
+ *   4. resolve   - read the byte values once every page is resident
+ * so each stage runs over cache-resident arrays and the fault I/O for a
+ * batch is grouped instead of scattered through the loop.
+ */
+template <typename TlbType = TLB, typename PageTableType = PageTable>
+class TranslationEngine {
+  private:
+    TlbType &tlb;
+    PageTableType &pageTable;
+    PhysicalMemory &physicalMemory;
+    BackingStore &backingStore;
+
+    // limited-frame mode: allocation (and eviction) goes through the
+    // frame allocator instead of the bump counter
+    FrameAllocator *frameAllocator = nullptr;
+
+    // write-back engine for dirty evicted pages (limited mode only)
+    WriteBackEngine *writeBack = nullptr;
+
+    // opt-in per-page heat-map accounting (--page-stats)
+    PageStatsEngine *pageStats = nullptr;
+
+    // out-of-order fault servicing for the batched path (--async-faults)
+    AsyncFaultEngine *asyncFaults = nullptr;
+
+    // compressed victim cache between the frames and the store
+    CompressedVictimCache *victimCache = nullptr;
+
+    // content-based frame sharing with copy-on-write (--dedup)
+    PageDeduplicator *dedup = nullptr;
+
+    uint16_t nextAvailableFrame = 0;
+
+    // stats counters, merged across all batches; atomics (relaxed -
+    // same plain add on x86) so the telemetry thread can snapshot
+    // them while the replay runs
+    std::atomic<long> totalAddresses{0};
+    std::atomic<long> tlbHits{0};
+    std::atomic<long> pageFaults{0};
+
+    // scratch buffers reused across batches so translateBatch never allocates
+    // on the hot path after the first call
+    std::vector<uint8_t> pageNumbers;
+    std::vector<uint8_t> offsets;
+
+    // queued page loads for the fault stage: <page number, assigned frame>
+    std::vector<std::pair<uint8_t, uint8_t>> pendingLoads;
+
+    // scratch for clustered multi-page reads in the streamed fault path
+    std::vector<int8_t> clusterBuffer;
+
+    /**
+     * Loads one page into a frame, aliasing when the store is mapped
+     */
+    void makeResident(uint8_t pageNumber, uint16_t frameNumber) {
+        ScopedStageTimer timer(Stage::BackingStoreRead);
+
+        // a page evicted dirty may still be queued for write-back;
+        // serve the re-fault from there, never from stale file data
+        if (writeBack != nullptr) {
+            int8_t pageData[PAGE_SIZE];
+            if (writeBack->fetchPending(pageNumber, pageData)) {
+                physicalMemory.loadPage(frameNumber, pageData);
+                return;
+            }
+        }
+
+        if (backingStore.isMapped()) {
+            physicalMemory.aliasPage(frameNumber, backingStore.pageData(pageNumber));
+            backingStore.prefetch(pageNumber);
+        } else {
+            int8_t pageData[PAGE_SIZE];
+            backingStore.readPage(pageNumber, pageData);
+            physicalMemory.loadPage(frameNumber, pageData);
+        }
+    }
+
+    /**
+     * Inline translation: every address completes end to end before
+     * the next starts. Used whenever the deferred stages cannot apply:
+     * limited-frame mode (an in-batch eviction could overwrite a frame
+     * an earlier deferred value read still needs) and batches carrying
+     * stores (a later load must observe an earlier store). Faults go
+     * through the FrameAllocator when present (evictions invalidate
+     * the displaced page via the reverse map, dirty pages are handed
+     * to the write-back engine) and the bump counter otherwise.
+     * @return false if physical memory filled up (bump mode only)
+     */
+    bool translateBatchInline(std::span<const uint32_t> addresses,
+                              std::span<TranslationResult> results) {
+        size_t count = addresses.size();
+        for (size_t i = 0; i < count; i++) {
+            uint32_t logicalAddress = addresses[i] & MASK;
+            uint8_t pageNumber = (logicalAddress >> BITSHIFT) & OFFSET_MASK;
+            uint8_t offset = logicalAddress & OFFSET_MASK;
+            bool isWrite = (addresses[i] & TRACE_WRITE_BIT) != 0;
+
+            if (pageStats != nullptr) {
+                pageStats->onReference(pageNumber);
+            }
+
+            std::optional<uint8_t> frameNumberOpt = tlb.getFrameNumber(pageNumber);
+            if (frameNumberOpt.has_value()) {
+                tlbHits.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                frameNumberOpt = pageTable.getFrameNumber(pageNumber);
+
+                if (!frameNumberOpt.has_value()) {
+                    pageFaults.fetch_add(1, std::memory_order_relaxed);
+                    if (pageStats != nullptr) {
+                        pageStats->onFault(pageNumber);
+                    }
+
+                    uint16_t frameNumber;
+                    bool resident = false; // dedup resolves residency itself
+                    if (frameAllocator != nullptr) {
+                        FrameAllocator::Allocation allocation = frameAllocator->allocate(pageNumber);
+                        if (allocation.evictedPage != -1) {
+                            // drop every stale mapping of the displaced page
+                            pageTable.invalidate(static_cast<uint8_t>(allocation.evictedPage));
+                            tlb.invalidate(static_cast<uint8_t>(allocation.evictedPage));
+
+                            // the victim's bytes go to the compressed
+                            // cache before the frame is overwritten
+                            if (victimCache != nullptr) {
+                                victimCache->store(static_cast<uint8_t>(allocation.evictedPage),
+                                                   physicalMemory.frameData(allocation.frameNumber));
+                            }
+
+                            // dirty victims go to the write-back queue
+                            // instead of blocking on a synchronous write
+                            if (frameAllocator->isDirty(allocation.frameNumber)) {
+                                if (writeBack != nullptr) {
+                                    writeBack->enqueue(static_cast<uint8_t>(allocation.evictedPage),
+                                                       physicalMemory.frameData(allocation.frameNumber));
+                                }
+                                frameAllocator->clearDirty(allocation.frameNumber);
+                            }
+                        }
+                        frameNumber = allocation.frameNumber;
+                    } else if (dedup != nullptr) {
+                        // content dedup: identical pages share a frame
+                        uint16_t sharedFrame;
+                        if (dedup->findByMemo(pageNumber, sharedFrame)) {
+                            // memoized content: no read, no new frame
+                            frameNumber = sharedFrame;
+                        } else {
+                            const int8_t *bytes;
+                            int8_t pageData[PAGE_SIZE];
+                            if (backingStore.isMapped()) {
+                                bytes = backingStore.pageData(pageNumber);
+                            } else {
+                                backingStore.readPage(pageNumber, pageData);
+                                bytes = pageData;
+                            }
+
+                            auto holderBytes = [this](uint16_t holder) {
+                                return physicalMemory.frameData(static_cast<uint8_t>(holder));
+                            };
+                            if (dedup->findByContent(pageNumber, bytes, holderBytes, sharedFrame)) {
+                                frameNumber = sharedFrame;
+                            } else {
+                                if (nextAvailableFrame >= FRAMES) {
+                                    return false; // physical memory is full
+                                }
+                                frameNumber = nextAvailableFrame++;
+                                if (backingStore.isMapped()) {
+                                    physicalMemory.aliasPage(static_cast<uint8_t>(frameNumber), bytes);
+                                } else {
+                                    physicalMemory.loadPage(static_cast<uint8_t>(frameNumber), bytes);
+                                }
+                                dedup->registerFrame(pageNumber, frameNumber);
+                            }
+                        }
+                        resident = true;
+                    } else {
+                        if (nextAvailableFrame >= FRAMES) {
+                            return false; // physical memory is full
+                        }
+                        frameNumber = nextAvailableFrame++;
+                    }
+
+                    // a re-faulted victim decompresses out of the
+                    // cache instead of paying the file's I/O cost
+                    if (!resident &&
+                        (victimCache == nullptr ||
+                         !victimCache->load(pageNumber, physicalMemory.frameStorage(frameNumber)))) {
+                        makeResident(pageNumber, frameNumber);
+                    }
+                    pageTable.setFrameNumber(pageNumber, static_cast<uint8_t>(frameNumber));
+                    tlb.addEntry(pageNumber, static_cast<uint8_t>(frameNumber));
+                    frameNumberOpt = static_cast<uint8_t>(frameNumber);
+                } else {
+                    // update TLB with page table result
+                    tlb.addEntry(pageNumber, frameNumberOpt.value());
+                }
+            }
+
+            if (frameAllocator != nullptr) {
+                frameAllocator->onAccess(frameNumberOpt.value());
+            }
+
+            uint16_t physicalAddress =
+                    static_cast<uint16_t>((frameNumberOpt.value() << 8) | offset);
+
+            if constexpr (requires { pageTable.markReferenced(pageNumber); }) {
+                pageTable.markReferenced(pageNumber);
+            }
+
+            if (isWrite) {
+                // a store to a shared frame breaks the sharing first:
+                // copy-on-write into a private frame for this page
+                if (dedup != nullptr && dedup->isShared(frameNumberOpt.value())) {
+                    if (nextAvailableFrame >= FRAMES) {
+                        return false; // physical memory is full
+                    }
+                    uint16_t privateFrame = nextAvailableFrame++;
+                    std::copy_n(physicalMemory.frameData(frameNumberOpt.value()), FRAME_SIZE,
+                                physicalMemory.frameStorage(static_cast<uint8_t>(privateFrame)));
+                    dedup->onCowCopy(pageNumber, frameNumberOpt.value(), privateFrame);
+                    pageTable.setFrameNumber(pageNumber, static_cast<uint8_t>(privateFrame));
+                    tlb.addEntry(pageNumber, static_cast<uint8_t>(privateFrame));
+                    frameNumberOpt = static_cast<uint8_t>(privateFrame);
+                    physicalAddress = static_cast<uint16_t>((frameNumberOpt.value() << 8) | offset);
+                }
+
+                // store: the address's low byte lands at the location
+                physicalMemory.setValue(physicalAddress, static_cast<int8_t>(offset));
+                if (dedup != nullptr) {
+                    // diverged content can never be shared again
+                    dedup->onFrameModified(frameNumberOpt.value());
+                }
+                if (frameAllocator != nullptr) {
+                    frameAllocator->markDirty(frameNumberOpt.value());
+                }
+                if constexpr (requires { pageTable.markDirty(pageNumber); }) {
+                    pageTable.markDirty(pageNumber);
+                }
+            }
+
+            results[i].logicalAddress = static_cast<uint16_t>(logicalAddress);
+            results[i].physicalAddress = physicalAddress;
+            results[i].value = physicalMemory.getValue(physicalAddress);
+        }
+        return true;
+    }
+
+    /** @return true when any record in the batch is a store */
+    static bool containsWrites(std::span<const uint32_t> addresses) {
+        for (uint32_t address : addresses) {
+            if (address & TRACE_WRITE_BIT)
+                return true;
+        }
+        return false;
+    }
+
+  public:
+    TranslationEngine(TlbType &tlb, PageTableType &pageTable,
+                      PhysicalMemory &physicalMemory, BackingStore &backingStore,
+                      FrameAllocator *frameAllocator = nullptr,
+                      WriteBackEngine *writeBack = nullptr,
+                      PageStatsEngine *pageStats = nullptr,
+                      AsyncFaultEngine *asyncFaults = nullptr,
+                      CompressedVictimCache *victimCache = nullptr,
+                      PageDeduplicator *dedup = nullptr)
+        : tlb(tlb), pageTable(pageTable),
+          physicalMemory(physicalMemory), backingStore(backingStore),
+          frameAllocator(frameAllocator), writeBack(writeBack), pageStats(pageStats),
+          asyncFaults(asyncFaults), victimCache(victimCache), dedup(dedup) {}
+
+    /**
+     * Translates a whole batch of logical addresses
+     * @param addresses raw 32-bit logical addresses (masked internally)
+     * @param results output span, one entry per input address
+     * @return false if physical memory filled up mid-batch
+     */
+    bool translateBatch(std::span<const uint32_t> addresses,
+                        std::span<TranslationResult> results) {
+        size_t count = addresses.size();
+        totalAddresses.fetch_add(static_cast<long>(count), std::memory_order_relaxed);
+
+        // deferred stages do not apply in limited-frame mode (in-batch
+        // evictions) or to batches carrying stores (ordering); those
+        // run each address end to end instead
+        if (frameAllocator != nullptr || dedup != nullptr || containsWrites(addresses)) {
+            return translateBatchInline(addresses, results);
+        }
+
+        // stage 1: decode every address into page number + offset
+        // (vectorized - AVX2/SSE2/NEON when available, scalar otherwise)
+        pageNumbers.resize(count);
+        offsets.resize(count);
+        decodeAddresses(addresses.data(), count, pageNumbers.data(), offsets.data());
+
+        // stage 2: resolve the mapping for the whole block
+        // TLB and page table are updated in order so hit/fault counts match
+        // the one-address-at-a-time loop exactly; only the page *data*
+        // movement is deferred to the fault stage
+        pendingLoads.clear();
+        for (size_t i = 0; i < count; i++) {
+            uint8_t pageNumber = pageNumbers[i];
+
+            if (pageStats != nullptr) {
+                pageStats->onReference(pageNumber);
+            }
+
+            std::optional<uint8_t> frameNumberOpt;
+            {
+                ScopedStageTimer timer(Stage::TlbLookup);
+                frameNumberOpt = tlb.getFrameNumber(pageNumber);
+            }
+            if (frameNumberOpt.has_value()) {
+                tlbHits.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                {
+                    ScopedStageTimer timer(Stage::PageTableLookup);
+                    frameNumberOpt = pageTable.getFrameNumber(pageNumber);
+                }
+
+                if (!frameNumberOpt.has_value()) {
+                    // page fault -> assign a frame now, load the data later
+                    pageFaults.fetch_add(1, std::memory_order_relaxed);
+                    if (pageStats != nullptr) {
+                        pageStats->onFault(pageNumber);
+                    }
+
+                    if (nextAvailableFrame >= FRAMES) {
+                        return false; // physical memory is full
+                    }
+
+                    uint8_t frameNumber = static_cast<uint8_t>(nextAvailableFrame);
+                    if (asyncFaults != nullptr && !backingStore.isMapped()) {
+                        // submit the read now and keep translating;
+                        // the batch synchronizes once, before stage 4
+                        asyncFaults->submitRead(pageNumber,
+                                                physicalMemory.frameStorage(frameNumber));
+                    } else {
+                        pendingLoads.emplace_back(pageNumber, frameNumber);
+                    }
+
+                    pageTable.setFrameNumber(pageNumber, frameNumber);
+                    tlb.addEntry(pageNumber, frameNumber);
+
+                    frameNumberOpt = frameNumber;
+                    nextAvailableFrame++;
+                } else {
+                    // update TLB with page table result
+                    tlb.addEntry(pageNumber, frameNumberOpt.value());
+                }
+            }
+
+            // tables with packed metadata get the reference bit fed
+            // in the same touch that resolved the mapping
+            if constexpr (requires { pageTable.markReferenced(pageNumber); }) {
+                pageTable.markReferenced(pageNumber);
+            }
+
+            results[i].logicalAddress = static_cast<uint16_t>(addresses[i] & MASK);
+            results[i].physicalAddress =
+                    static_cast<uint16_t>((frameNumberOpt.value() << 8) | offsets[i]);
+        }
+
+        // stage 3: service all of the batch's page faults together.
+        // mapped store: zero-copy aliasing, nothing to cluster.
+        // streamed store: sort the batch's faulting pages and service
+        // each run of contiguous pages with one large read
+        if (asyncFaults != nullptr && !backingStore.isMapped()) {
+            // the reads were submitted as the faults were found; one
+            // synchronization point collects the stragglers
+            ScopedStageTimer timer(Stage::BackingStoreRead);
+            asyncFaults->waitAll();
+        } else if (backingStore.isMapped()) {
+            for (const auto &[pageNumber, frameNumber] : pendingLoads) {
+                physicalMemory.aliasPage(frameNumber, backingStore.pageData(pageNumber));
+                backingStore.prefetch(pageNumber);
+            }
+        } else if (!pendingLoads.empty()) {
+            std::sort(pendingLoads.begin(), pendingLoads.end());
+
+            size_t runStart = 0;
+            for (size_t i = 1; i <= pendingLoads.size(); i++) {
+                // run ends when the next page is not the direct successor
+                if (i < pendingLoads.size() &&
+                    pendingLoads[i].first == pendingLoads[i - 1].first + 1) {
+                    continue;
+                }
+
+                size_t runLength = i - runStart;
+                clusterBuffer.resize(runLength * PAGE_SIZE);
+                {
+                    ScopedStageTimer timer(Stage::BackingStoreRead);
+                    backingStore.readRange(pendingLoads[runStart].first, runLength,
+                                           clusterBuffer.data());
+                }
+                for (size_t page = 0; page < runLength; page++) {
+                    physicalMemory.loadPage(pendingLoads[runStart + page].second,
+                                            clusterBuffer.data() + page * PAGE_SIZE);
+                }
+                runStart = i;
+            }
+        }
+
+        // stage 4: every page is resident now, pull the byte values.
+        // the physical addresses are known ahead, so each iteration
+        // prefetches the line a later load will touch - by the time
+        // the loop reaches it, the data is (usually) already in cache
+        constexpr size_t PREFETCH_DISTANCE = 8;
+        for (size_t i = 0; i < count; i++) {
+            if (i + PREFETCH_DISTANCE < count) {
+                physicalMemory.prefetchValue(results[i + PREFETCH_DISTANCE].physicalAddress);
+            }
+            ScopedStageTimer timer(Stage::MemoryAccess);
+            results[i].value = physicalMemory.getValue(results[i].physicalAddress);
+        }
+
+        return true;
+    }
+
+    /**
+     * Rewinds TLB/page-table/frame state and counters so the next
+     * trace of a batch replays cold without rebuilding the objects
+     * (the radix table's arena makes its part a pointer reset)
+     */
+    void resetForNextTrace() {
+        tlb.reset();
+        pageTable.reset();
+        if (pageStats != nullptr) {
+            pageStats->reset();
+        }
+        if (dedup != nullptr) {
+            dedup->reset();
+        }
+        nextAvailableFrame = 0;
+        totalAddresses.store(0, std::memory_order_relaxed);
+        tlbHits.store(0, std::memory_order_relaxed);
+        pageFaults.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Serializes the warm state (counters, TLB, page table, resident
+     * frames) into one fixed-layout binary image
+     * @param fileName checkpoint path
+     * @return false on I/O failure
+     */
+    bool saveState(const std::string &fileName) {
+        auto image = std::make_unique<CheckpointImage>();
+        image->magic = CHECKPOINT_MAGIC;
+        image->version = CHECKPOINT_VERSION;
+        image->totalAddresses = totalAddresses.load();
+        image->tlbHits = tlbHits.load();
+        image->pageFaults = pageFaults.load();
+        image->nextAvailableFrame = nextAvailableFrame;
+
+        std::vector<std::pair<uint8_t, uint8_t>> entries = tlb.snapshot();
+        image->tlbEntryCount = static_cast<uint16_t>(entries.size());
+        for (size_t i = 0; i < entries.size() && i < CHECKPOINT_MAX_TLB_ENTRIES; i++) {
+            image->tlbEntries[i] = {entries[i].first, entries[i].second};
+        }
+
+        for (unsigned page = 0; page < PAGE_TABLE_SIZE; page++) {
+            std::optional<uint8_t> frameNumber =
+                    pageTable.getFrameNumber(static_cast<uint8_t>(page));
+            image->pageTable[page] =
+                    frameNumber.has_value() ? static_cast<int16_t>(frameNumber.value()) : -1;
+        }
+
+        for (unsigned frame = 0; frame < FRAMES; frame++) {
+            std::copy_n(physicalMemory.frameData(static_cast<uint8_t>(frame)), FRAME_SIZE,
+                        image->frameData[frame].begin());
+        }
+
+        std::ofstream checkpointFile(fileName, std::ios::binary);
+        checkpointFile.write(reinterpret_cast<const char *>(image.get()), sizeof(CheckpointImage));
+        return static_cast<bool>(checkpointFile);
+    }
+
+    /**
+     * Restores the warm state saved by saveState
+     * @param fileName checkpoint path
+     * @return false when the file is missing, short, or mismatched
+     */
+    bool loadState(const std::string &fileName) {
+        auto image = std::make_unique<CheckpointImage>();
+        std::ifstream checkpointFile(fileName, std::ios::binary);
+        checkpointFile.read(reinterpret_cast<char *>(image.get()), sizeof(CheckpointImage));
+        if (!checkpointFile || image->magic != CHECKPOINT_MAGIC ||
+            image->version != CHECKPOINT_VERSION ||
+            image->tlbEntryCount > CHECKPOINT_MAX_TLB_ENTRIES) {
+            return false;
+        }
+
+        totalAddresses.store(image->totalAddresses);
+        tlbHits.store(image->tlbHits);
+        pageFaults.store(image->pageFaults);
+        nextAvailableFrame = image->nextAvailableFrame;
+
+        std::vector<std::pair<uint8_t, uint8_t>> entries;
+        entries.reserve(image->tlbEntryCount);
+        for (unsigned i = 0; i < image->tlbEntryCount; i++) {
+            entries.emplace_back(image->tlbEntries[i].pageNumber, image->tlbEntries[i].frameNumber);
+        }
+        tlb.restore(entries);
+
+        pageTable.reset();
+        for (unsigned page = 0; page < PAGE_TABLE_SIZE; page++) {
+            if (image->pageTable[page] != -1) {
+                pageTable.setFrameNumber(static_cast<uint8_t>(page),
+                                         static_cast<uint8_t>(image->pageTable[page]));
+            }
+        }
+
+        for (unsigned frame = 0; frame < FRAMES; frame++) {
+            physicalMemory.loadPage(static_cast<uint8_t>(frame), image->frameData[frame].data());
+        }
+
+        return true;
+    }
+
+    long getTotalAddresses() const { return totalAddresses.load(std::memory_order_relaxed); }
+    long getTlbHits() const { return tlbHits.load(std::memory_order_relaxed); }
+    long getPageFaults() const { return pageFaults.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,282 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "binary_trace.h"
+#include "tlb.h"
+#include "indexed_tlb.h"
+#include "tlb_hierarchy.h"
+#include "tlb_policy.h"
+#include "huge_page.h"
+#include "page_table.h"
+#include "physical_memory.h"
+#include "backing_store.h"
+#include "frame_allocator.h"
+#include "translation_engine.h"
+
+/**
+ * Deterministic A/B harness: one invocation loads and decodes a trace
+ * once, replays it through two configured engine variants over the
+ * same in-memory address block, and reports the per-variant numbers
+ * side by side with deltas - hit rate, fault count, estimated cycles,
+ * wall time - plus the first address index where the two variants'
+ * translations diverge (the first thing to look at when a policy
+ * change misbehaves). An A/B experiment therefore costs barely more
+ * than one run instead of two full replays with duplicated ingest.
+ *
+ * A variant spec is  <tlb>[:<frames>:<policy>]  - e.g. "indexed" or
+ * "lru:128:clock" - where <tlb> is any of the simulator's TLB modes.
+ */
+
+namespace {
+
+/** One variant's replay outcome */
+struct VariantResult {
+    std::string spec;
+    long totalAddresses = 0;
+    long tlbHits = 0;
+    long pageFaults = 0;
+    double wallMilliseconds = 0.0;
+
+    double hitRate() const {
+        return totalAddresses > 0 ? 100.0 * tlbHits / totalAddresses : 0.0;
+    }
+
+    /** same simple cost model the policy comparison uses */
+    uint64_t estimatedCycles() const {
+        long misses = totalAddresses - tlbHits;
+        return static_cast<uint64_t>(tlbHits) * TLB_POLICY_HIT_CYCLES +
+               static_cast<uint64_t>(misses) * (TLB_POLICY_HIT_CYCLES + TLB_POLICY_MISS_CYCLES);
+    }
+};
+
+/** Parsed variant spec */
+struct VariantSpec {
+    std::string tlbMode = "deque";
+    unsigned frameBudget = 0;
+    std::string evictionPolicy = "clock";
+};
+
+VariantSpec parseSpec(const std::string &spec) {
+    VariantSpec parsed;
+    size_t first = spec.find(':');
+    if (first == std::string::npos) {
+        parsed.tlbMode = spec;
+        return parsed;
+    }
+    parsed.tlbMode = spec.substr(0, first);
+    size_t second = spec.find(':', first + 1);
+    if (second == std::string::npos) {
+        parsed.frameBudget = std::stoul(spec.substr(first + 1));
+    } else {
+        parsed.frameBudget = std::stoul(spec.substr(first + 1, second - first - 1));
+        parsed.evictionPolicy = spec.substr(second + 1);
+    }
+    return parsed;
+}
+
+/** @class VariantRunner
+ *  @brief Type-erased handle on one engine variant
+ *
+ * Lets two variants with different TLB types advance batch by batch
+ * side by side, so the comparison needs two batch buffers instead of
+ * two full result vectors.
+ */
+class VariantRunner {
+  public:
+    virtual ~VariantRunner() = default;
+    virtual void translate(std::span<const uint32_t> batch,
+                           std::span<TranslationResult> results) = 0;
+    virtual void fill(VariantResult &out) = 0;
+};
+
+template <typename TlbType>
+class TypedVariantRunner : public VariantRunner {
+  private:
+    TlbType tlb;
+    PageTable pageTable;
+    PhysicalMemory physicalMemory;
+    BackingStore backingStore;
+    std::optional<FrameAllocator> frameAllocator;
+    std::optional<TranslationEngine<TlbType>> engine;
+    double wallMilliseconds = 0.0;
+
+  public:
+    explicit TypedVariantRunner(const VariantSpec &spec) : backingStore("BACKING_STORE.bin") {
+        if (spec.frameBudget > 0) {
+            frameAllocator.emplace(static_cast<uint16_t>(spec.frameBudget), spec.evictionPolicy);
+        }
+        engine.emplace(tlb, pageTable, physicalMemory, backingStore,
+                       frameAllocator.has_value() ? &*frameAllocator : nullptr);
+    }
+
+    void translate(std::span<const uint32_t> batch,
+                   std::span<TranslationResult> results) override {
+        auto start = std::chrono::steady_clock::now();
+        if (!engine->translateBatch(batch, results)) {
+            std::cerr << "Error: Physical memory is full." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        wallMilliseconds +=
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                        .count();
+    }
+
+    void fill(VariantResult &out) override {
+        out.totalAddresses = engine->getTotalAddresses();
+        out.tlbHits = engine->getTlbHits();
+        out.pageFaults = engine->getPageFaults();
+        out.wallMilliseconds = wallMilliseconds;
+    }
+};
+
+std::unique_ptr<VariantRunner> makeRunner(const std::string &specText) {
+    VariantSpec spec = parseSpec(specText);
+    if (spec.tlbMode == "deque")
+        return std::make_unique<TypedVariantRunner<TLB>>(spec);
+    if (spec.tlbMode == "indexed")
+        return std::make_unique<TypedVariantRunner<IndexedTLB>>(spec);
+    if (spec.tlbMode == "hierarchy")
+        return std::make_unique<TypedVariantRunner<TlbHierarchy>>(spec);
+    if (spec.tlbMode == "huge")
+        return std::make_unique<TypedVariantRunner<HugePageTLB>>(spec);
+    if (spec.tlbMode == "lru")
+        return std::make_unique<TypedVariantRunner<LruPolicyTLB>>(spec);
+    if (spec.tlbMode == "slru")
+        return std::make_unique<TypedVariantRunner<SlruPolicyTLB>>(spec);
+    if (spec.tlbMode == "2q")
+        return std::make_unique<TypedVariantRunner<TwoQPolicyTLB>>(spec);
+    if (spec.tlbMode == "random")
+        return std::make_unique<TypedVariantRunner<RandomPolicyTLB>>(spec);
+
+    std::cerr << "Unknown TLB mode in variant spec: " << spec.tlbMode << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string traceFile;
+    std::string specA = "deque";
+    std::string specB = "indexed";
+
+    for (int arg = 1; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option.rfind("--a=", 0) == 0) {
+            specA = option.substr(4);
+        } else if (option.rfind("--b=", 0) == 0) {
+            specB = option.substr(4);
+        } else if (option.rfind("--", 0) != 0) {
+            traceFile = option;
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (traceFile.empty()) {
+        std::cerr << "Usage: ./vmm_ab addresses.txt|addresses" << BINARY_TRACE_EXTENSION
+                  << " [--a=<tlb>[:<frames>:<policy>]] [--b=<tlb>[:<frames>:<policy>]]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // ingest the trace once; both variants share the decoded block
+    std::optional<BinaryTraceFile> binaryTrace;
+    std::vector<uint32_t> addresses;
+    std::span<const uint32_t> records;
+
+    if (isBinaryTrace(traceFile)) {
+        binaryTrace.emplace(traceFile);
+        records = binaryTrace->records();
+    } else {
+        std::ifstream addressFile(traceFile);
+        if (!addressFile) {
+            std::cerr << "Error opening address file: " << traceFile << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::string line;
+        while (std::getline(addressFile, line)) {
+            // mask to the virtual address width so a raw decimal with
+            // bit 31 set is not misread as a store by the engine
+            addresses.push_back(static_cast<uint32_t>(std::stoul(line)) & MASK);
+        }
+        records = addresses;
+    }
+
+    // both variants advance batch by batch over the shared block, so
+    // memory stays O(batch) no matter how long the trace is
+    std::unique_ptr<VariantRunner> runnerA = makeRunner(specA);
+    std::unique_ptr<VariantRunner> runnerB = makeRunner(specB);
+
+    std::vector<TranslationResult> batchA(BATCH_SIZE);
+    std::vector<TranslationResult> batchB(BATCH_SIZE);
+    long firstDivergence = -1;
+
+    for (size_t offset = 0; offset < records.size(); offset += BATCH_SIZE) {
+        size_t count = std::min<size_t>(BATCH_SIZE, records.size() - offset);
+        std::span<const uint32_t> batch = records.subspan(offset, count);
+
+        runnerA->translate(batch, {batchA.data(), count});
+        runnerB->translate(batch, {batchB.data(), count});
+
+        if (firstDivergence < 0) {
+            for (size_t i = 0; i < count; i++) {
+                if (batchA[i].physicalAddress != batchB[i].physicalAddress ||
+                    batchA[i].value != batchB[i].value) {
+                    firstDivergence = static_cast<long>(offset + i);
+                    break;
+                }
+            }
+        }
+    }
+
+    VariantResult a;
+    a.spec = specA;
+    runnerA->fill(a);
+    VariantResult b;
+    b.spec = specB;
+    runnerB->fill(b);
+
+    // re-derive the diverging logical address for the report
+    uint16_t divergingLogical = 0;
+    if (firstDivergence >= 0) {
+        divergingLogical = static_cast<uint16_t>(records[firstDivergence] & MASK);
+    }
+
+    std::cout << "A/B replay over " << records.size() << " addresses" << std::endl;
+    std::cout << std::left << std::setw(22) << "variant" << std::right << std::setw(12) << "hits"
+              << std::setw(12) << "hit rate" << std::setw(10) << "faults" << std::setw(15)
+              << "est. cycles" << std::setw(12) << "wall ms" << std::endl;
+    for (const VariantResult *variant : {&a, &b}) {
+        std::cout << std::left << std::setw(22) << variant->spec << std::right << std::setw(12)
+                  << variant->tlbHits << std::setw(11) << std::fixed << std::setprecision(2)
+                  << variant->hitRate() << "%" << std::setw(10) << variant->pageFaults
+                  << std::setw(15) << variant->estimatedCycles() << std::setw(12)
+                  << std::setprecision(3) << variant->wallMilliseconds << std::endl;
+    }
+
+    std::cout << "delta: hits " << std::showpos << (b.tlbHits - a.tlbHits) << ", faults "
+              << (b.pageFaults - a.pageFaults) << ", est. cycles "
+              << (static_cast<int64_t>(b.estimatedCycles()) -
+                  static_cast<int64_t>(a.estimatedCycles()))
+              << std::noshowpos << std::endl;
+
+    if (firstDivergence >= 0) {
+        std::cout << "first diverging address index: " << firstDivergence << " (logical 0x"
+                  << std::hex << std::setw(4) << std::setfill('0') << divergingLogical
+                  << std::dec << std::setfill(' ') << ")" << std::endl;
+    } else {
+        std::cout << "translations identical across both variants" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
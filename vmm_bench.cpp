@@ -0,0 +1,224 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "tlb.h"
+#include "indexed_tlb.h"
+#include "page_table.h"
+#include "radix_page_table.h"
+#include "inverted_page_table.h"
+#include "physical_memory.h"
+#include "backing_store.h"
+#include "simd_decode.h"
+#include "workload_gen.h"
+#include "translation_engine.h"
+
+/**
+ * Self-contained microbenchmark harness for the translation stages.
+ * No external dependency (Google Benchmark is overkill for five
+ * kernels); each benchmark runs its operation in a tight loop across
+ * several repetitions and reports the best and mean ns/op, so a
+ * per-stage regression shows up directly instead of being inferred
+ * from end-to-end wall clock.
+ */
+
+// keep the compiler from deleting a benchmarked computation
+template <typename T>
+static inline void doNotOptimize(const T &value) {
+    asm volatile("" : : "g"(value) : "memory");
+}
+
+/**
+ * Runs one benchmark body repeatedly and prints best/mean ns per op
+ * @param name row label
+ * @param iterations operations per repetition
+ * @param body callable executing exactly one operation per call
+ */
+template <typename Body>
+static void bench(const std::string &name, size_t iterations, Body &&body) {
+    constexpr int repetitions = 5;
+    double bestNs = 1e300;
+    double totalNs = 0.0;
+
+    for (int rep = 0; rep < repetitions; rep++) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            body(i);
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() /
+                    static_cast<double>(iterations);
+        bestNs = std::min(bestNs, ns);
+        totalNs += ns;
+    }
+
+    std::cout << std::left << std::setw(44) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << bestNs << " ns/op (best)"
+              << std::setw(10) << totalNs / repetitions << " ns/op (mean)" << std::endl;
+}
+
+/**
+ * TLB lookup benchmarks at a given occupancy, hit and miss paths
+ */
+template <typename TlbType>
+static void benchTlb(const std::string &label, int occupancy) {
+    TlbType tlb;
+    for (int page = 0; page < occupancy; page++) {
+        tlb.addEntry(static_cast<uint8_t>(page), static_cast<uint8_t>(page));
+    }
+
+    bench(label + " hit (occupancy " + std::to_string(occupancy) + ")", 1 << 20,
+          [&](size_t i) {
+              auto frame = tlb.getFrameNumber(static_cast<uint8_t>(i % occupancy));
+              doNotOptimize(frame);
+          });
+
+    bench(label + " miss (occupancy " + std::to_string(occupancy) + ")", 1 << 20,
+          [&](size_t i) {
+              // pages above the occupied range always miss
+              auto frame = tlb.getFrameNumber(static_cast<uint8_t>(occupancy + i % (PAGE_TABLE_SIZE - occupancy)));
+              doNotOptimize(frame);
+          });
+}
+
+/**
+ * TLB insert benchmark under full replacement pressure
+ */
+template <typename TlbType>
+static void benchTlbInsert(const std::string &label) {
+    TlbType tlb;
+    bench(label + " addEntry (replacement pressure)", 1 << 20, [&](size_t i) {
+        tlb.addEntry(static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8));
+    });
+}
+
+/**
+ * Full translate-one-address round trips over a synthetic workload
+ */
+static void benchRoundTrip(const std::string &label, const std::vector<uint32_t> &workload) {
+    IndexedTLB tlb;
+    PageTable pageTable;
+    PhysicalMemory physicalMemory;
+    BackingStore backingStore("BACKING_STORE.bin");
+    TranslationEngine<IndexedTLB> engine(tlb, pageTable, physicalMemory, backingStore);
+
+    TranslationResult result;
+    bench("translate round trip (" + label + ")", workload.size(), [&](size_t i) {
+        engine.translateBatch({&workload[i], 1}, {&result, 1});
+        doNotOptimize(result);
+    });
+}
+
+int main() {
+    std::cout << "vmm_bench - per-stage microbenchmarks" << std::endl;
+    std::cout << std::string(88, '-') << std::endl;
+
+    // TLB lookups at low and full occupancy, both implementations
+    benchTlb<TLB>("TLB(deque)", 4);
+    benchTlb<TLB>("TLB(deque)", TLB_SIZE);
+    benchTlb<IndexedTLB>("TLB(indexed)", 4);
+    benchTlb<IndexedTLB>("TLB(indexed)", TLB_SIZE);
+
+    benchTlbInsert<TLB>("TLB(deque)");
+    benchTlbInsert<IndexedTLB>("TLB(indexed)");
+
+    // page table lookup
+    {
+        PageTable pageTable;
+        for (int page = 0; page < PAGE_TABLE_SIZE; page += 2) {
+            pageTable.setFrameNumber(static_cast<uint8_t>(page), static_cast<uint8_t>(page));
+        }
+        bench("PageTable getFrameNumber", 1 << 20, [&](size_t i) {
+            auto frame = pageTable.getFrameNumber(static_cast<uint8_t>(i));
+            doNotOptimize(frame);
+        });
+    }
+
+    // radix page table at x86-64 geometry over a sparse 48-bit space
+    {
+        RadixPageTable<48, 12, 9> radixTable;
+        Xorshift sparseRng(0xC0FFEE);
+        std::vector<uint64_t> sparsePages(4096);
+        for (size_t i = 0; i < sparsePages.size(); i++) {
+            sparsePages[i] = sparseRng.next() & ((uint64_t{1} << 36) - 1);
+            radixTable.setFrameNumber(sparsePages[i], i);
+        }
+        bench("RadixPageTable(48-bit) getFrameNumber", 1 << 20, [&](size_t i) {
+            auto frame = radixTable.getFrameNumber(sparsePages[i % sparsePages.size()]);
+            doNotOptimize(frame);
+        });
+        std::cout << "  (4096 sparse mappings -> " << radixTable.getNodeCount()
+                  << " nodes allocated lazily)" << std::endl;
+    }
+
+    // inverted page table (frame-proportional memory) vs the flat/radix walks
+    {
+        InvertedPageTable invertedTable;
+        for (int page = 0; page < FRAMES; page++) {
+            invertedTable.setFrameNumber(static_cast<uint8_t>(page), static_cast<uint8_t>(page));
+        }
+        bench("InvertedPageTable getFrameNumber", 1 << 20, [&](size_t i) {
+            auto frame = invertedTable.getFrameNumber(static_cast<uint8_t>(i));
+            doNotOptimize(frame);
+        });
+    }
+
+    // backing store reads: cold pages stream through, warm re-reads one
+    {
+        BackingStore backingStore("BACKING_STORE.bin");
+        int8_t buffer[PAGE_SIZE];
+        bench("BackingStore readPage cold (sweep)", 1 << 16, [&](size_t i) {
+            backingStore.readPage(static_cast<uint8_t>(i), buffer);
+            doNotOptimize(buffer[0]);
+        });
+        bench("BackingStore readPage warm (page 0)", 1 << 16, [&](size_t) {
+            backingStore.readPage(0, buffer);
+            doNotOptimize(buffer[0]);
+        });
+    }
+
+    // synthetic workloads with controllable locality
+    const size_t workloadSize = 1 << 18;
+    std::vector<uint32_t> sequential(workloadSize);
+    for (size_t i = 0; i < workloadSize; i++) {
+        sequential[i] = static_cast<uint32_t>(i % (1 << 16));
+    }
+
+    Xorshift rng;
+    std::vector<uint32_t> uniform(workloadSize);
+    for (uint32_t &address : uniform) {
+        address = static_cast<uint32_t>(rng.next() & MASK);
+    }
+
+    ZipfianGenerator zipf(PAGE_TABLE_SIZE, 0.99);
+    std::vector<uint32_t> zipfian(workloadSize);
+    for (uint32_t &address : zipfian) {
+        address = static_cast<uint32_t>((zipf.next() << BITSHIFT) | (rng.next() & OFFSET_MASK));
+    }
+
+    // decode stage kernel (vectorized vs scalar reference)
+    {
+        std::vector<uint8_t> pages(workloadSize);
+        std::vector<uint8_t> offsets(workloadSize);
+        bench("decode block scalar", 1 << 6, [&](size_t) {
+            decodeAddressesScalar(uniform.data(), workloadSize, pages.data(), offsets.data());
+            doNotOptimize(pages[0]);
+        });
+        bench("decode block simd", 1 << 6, [&](size_t) {
+            decodeAddresses(uniform.data(), workloadSize, pages.data(), offsets.data());
+            doNotOptimize(pages[0]);
+        });
+    }
+
+    benchRoundTrip("sequential", sequential);
+    benchRoundTrip("uniform random", uniform);
+    benchRoundTrip("zipfian 0.99", zipfian);
+
+    return EXIT_SUCCESS;
+}
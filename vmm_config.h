@@ -0,0 +1,38 @@
+#pragma once
+
+#include "geometry.h"
+
+// The deployed geometry instantiations. Each one is built as its own
+// specialized executable (CMakeLists.txt adds a target per entry), so
+// trying a different configuration is a build target, not a source
+// edit - and every derived constant stays compile-time.
+#if defined(VMM_GEOMETRY_TLB64)
+// 64-entry TLB build, matching the L1 capacity of the deploy hosts
+using DefaultGeometry = Geometry<16, 8, 256, 64>;
+#elif defined(VMM_GEOMETRY_TLB1024)
+// 1024-entry TLB build for modeling the large second-level hardware
+using DefaultGeometry = Geometry<16, 8, 256, 1024>;
+#else
+// the classic simulator geometry: 64 KiB virtual space, 256-byte
+// pages, 256 frames, 16-entry TLB
+using DefaultGeometry = Geometry<16, 8, 256, 16>;
+#endif
+
+// the record/output types still carry 8-bit page and frame numbers;
+// wider geometries need that plumbing widened before they can ship
+static_assert(sizeof(DefaultGeometry::PageNumberType) == 1 &&
+                      sizeof(DefaultGeometry::FrameNumberType) == 1,
+              "current pipeline stores page/frame numbers in 8 bits");
+
+// historical names, now resolving to the geometry's derived constants
+// (kept so two decades of call sites read unchanged)
+#define PAGE_TABLE_SIZE (DefaultGeometry::PAGE_COUNT) // max number of pages in the virtual mem
+#define PAGE_SIZE (DefaultGeometry::PAGE_BYTES)       // size of each page in bytes
+#define TLB_SIZE (DefaultGeometry::TLB_ENTRIES)       // buffer size
+#define FRAME_SIZE (DefaultGeometry::FRAME_BYTES)     // size of each physical mem frame
+#define FRAMES (DefaultGeometry::FRAME_COUNT)         // total frames in the physical mem
+#define BITSHIFT (DefaultGeometry::PAGE_SHIFT)
+#define MASK (DefaultGeometry::ADDRESS_MASK)      // mask to extract the virtual address bits
+#define OFFSET_MASK (DefaultGeometry::OFFSET_MASK) // mask to extract the in-page offset
+
+#define BATCH_SIZE 4096 // addresses processed per pipeline batch
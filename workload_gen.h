@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+/** @class Xorshift
+ *  @brief Tiny deterministic PRNG, much faster than rand()
+ */
+class Xorshift {
+  private:
+    uint64_t state;
+
+  public:
+    explicit Xorshift(uint64_t seed = 0x9E3779B97F4A7C15ull) : state(seed ? seed : 1) {}
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    /** Uniform double in [0, 1) */
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+};
+
+/** @class ZipfianGenerator
+ *  @brief Skewed page popularity, sampled via an inverse-CDF search
+ */
+class ZipfianGenerator {
+  private:
+    std::vector<double> cdf;
+    Xorshift rng;
+
+  public:
+    ZipfianGenerator(size_t universe, double skew, uint64_t seed = 0x9E3779B97F4A7C15ull)
+        : rng(seed) {
+        cdf.resize(universe);
+        double total = 0.0;
+        for (size_t rank = 0; rank < universe; rank++) {
+            total += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+            cdf[rank] = total;
+        }
+        for (double &entry : cdf)
+            entry /= total;
+    }
+
+    size_t next() {
+        double point = rng.nextDouble();
+        // binary search the CDF for the sampled rank
+        size_t low = 0, high = cdf.size() - 1;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (cdf[mid] < point)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    }
+};
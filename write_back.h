@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "vmm_config.h"
+#include "backing_store.h"
+
+/** @class WriteBackEngine
+ *  @brief Coalescing background writer for dirty evicted pages
+ *
+ * Eviction in limited-frame mode hands dirty pages here instead of
+ * blocking the translation loop on a 256-byte write each. A background
+ * thread drains the pending set, sorts it, and writes every run of
+ * adjacent pages with one large sequential write.
+ *
+ * Until a page's write-back has retired it stays in the pending set,
+ * and fetchPending() serves re-faults from there - so a page evicted
+ * dirty and faulted right back never reads stale file contents.
+ */
+class WriteBackEngine {
+  private:
+    BackingStore &backingStore;
+
+    // dirty pages awaiting write-back (latest contents win)
+    std::unordered_map<uint8_t, std::vector<int8_t>> pending;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable drained;
+    std::thread writerThread;
+    bool shuttingDown = false;
+
+    /**
+     * Writer thread body: drain the pending set in coalesced runs
+     */
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            workReady.wait(lock, [&] { return !pending.empty() || shuttingDown; });
+            if (pending.empty() && shuttingDown)
+                return;
+
+            // snapshot the dirty pages, sorted for coalescing; the
+            // entries stay in the pending set (copied, not moved) so a
+            // refault during the write still sees the stored bytes
+            std::vector<std::pair<uint8_t, std::vector<int8_t>>> batch;
+            batch.reserve(pending.size());
+            for (const auto &[pageNumber, pageData] : pending) {
+                batch.emplace_back(pageNumber, pageData);
+            }
+            std::sort(batch.begin(), batch.end(),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+
+            lock.unlock();
+
+            // one sequential write per run of adjacent pages
+            std::vector<int8_t> runBuffer;
+            size_t runStart = 0;
+            for (size_t i = 1; i <= batch.size(); i++) {
+                if (i < batch.size() && batch[i].first == batch[i - 1].first + 1) {
+                    continue;
+                }
+                size_t runLength = i - runStart;
+                runBuffer.resize(runLength * PAGE_SIZE);
+                for (size_t page = 0; page < runLength; page++) {
+                    std::copy_n(batch[runStart + page].second.data(), PAGE_SIZE,
+                                runBuffer.data() + page * PAGE_SIZE);
+                }
+                backingStore.writeRange(batch[runStart].first, runLength, runBuffer.data());
+                runStart = i;
+            }
+
+            lock.lock();
+
+            // retire only pages that were not re-dirtied while writing
+            // (content comparison: a re-dirtied page has fresher bytes
+            // and must go through another write)
+            for (const auto &[pageNumber, pageData] : batch) {
+                auto entry = pending.find(pageNumber);
+                if (entry != pending.end() && entry->second == pageData) {
+                    pending.erase(entry);
+                }
+            }
+            if (pending.empty()) {
+                drained.notify_all();
+            }
+        }
+    }
+
+  public:
+    explicit WriteBackEngine(BackingStore &backingStore) : backingStore(backingStore) {
+        writerThread = std::thread(&WriteBackEngine::writerLoop, this);
+    }
+
+    /**
+     * Destructor: flush every pending page, then stop the writer
+     */
+    ~WriteBackEngine() {
+        flush();
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            shuttingDown = true;
+        }
+        workReady.notify_one();
+        writerThread.join();
+    }
+
+    /**
+     * Queues a dirty page for write-back (called on eviction)
+     * @param pageNumber evicted page
+     * @param pageData the frame's current contents, copied out
+     */
+    void enqueue(uint8_t pageNumber, const int8_t *pageData) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            pending[pageNumber].assign(pageData, pageData + PAGE_SIZE);
+        }
+        workReady.notify_one();
+    }
+
+    /**
+     * Serves a re-fault from the pending set, if the page is there
+     * @param pageNumber faulting page
+     * @param buffer output, PAGE_SIZE bytes on success
+     * @return true when the page was pending and buffer was filled
+     */
+    bool fetchPending(uint8_t pageNumber, int8_t *buffer) {
+        std::lock_guard<std::mutex> guard(mutex);
+        auto entry = pending.find(pageNumber);
+        if (entry == pending.end())
+            return false;
+        std::copy_n(entry->second.data(), PAGE_SIZE, buffer);
+        return true;
+    }
+
+    /**
+     * Blocks until every queued page has reached the backing file
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        workReady.notify_one();
+        drained.wait(lock, [&] { return pending.empty(); });
+    }
+};